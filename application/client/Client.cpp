@@ -22,6 +22,8 @@
 
 #include "Client.h"
 #include "network/SocketOption.h"
+#include "network/Reactor.h"
+#include "network/SocketException.h"
 
 namespace sdk {
 	namespace application {
@@ -76,6 +78,24 @@ namespace sdk {
 			return m_socketDesc->read(message, maxSize);
 		}
 
+		bool Client::isAlive() const noexcept
+		{
+			return m_socketDesc && isSocketAlive(m_socketDesc->getSocketId());
+		}
+
+		bool Client::isSocketAlive(SOCKET socketId) noexcept
+		{
+			try {
+				//	An idle connection is readable only if the server closed it or sent unexpected data,
+				//	it is not peeked because a blocking socket could wait on a spurious readiness.
+				const auto events = network::Reactor::waitFor(socketId, network::EVENT_READ, 0);
+				return (events & (network::EVENT_READ | network::EVENT_ERROR)) == 0;
+			}
+			catch (const general::SocketException&) {
+				return false;
+			}
+		}
+
 		void Client::abortConnection() noexcept
 		{
 			m_abortConnection = true;
@@ -45,12 +45,23 @@ namespace sdk {
 			NODISCARD virtual std::size_t read(std::vector<unsigned char>& responseMsg, int maxSize = 0) const;
 			NODISCARD virtual std::size_t read(std::string& message, int maxSize = 0) const;
 
+			/**
+			 * @brief Checks without blocking whether the connection is still usable. A connection
+			 * that is closed by the server or has unread data is not usable for a new request.
+			 * @return true if the client is connected and idle.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD virtual bool isAlive() const noexcept;
+
 			void abortConnection() noexcept;
 			NODISCARD bool isConnectionAborted() const noexcept
 			{
 				return m_abortConnection;
 			}
 
+		protected:
+			NODISCARD static bool isSocketAlive(SOCKET socketId) noexcept;
+
 		private:
 			bool m_abortConnection{};
 			network::Socket m_socket;
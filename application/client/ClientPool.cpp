@@ -0,0 +1,190 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ClientPool.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace sdk {
+	namespace application {
+
+		PooledClient::~PooledClient()
+		{
+			release();
+		}
+
+		PooledClient::PooledClient(PooledClient&& other) noexcept :
+			m_anchor{ std::move(other.m_anchor) },
+			m_endpoint{ std::move(other.m_endpoint) },
+			m_client{ std::move(other.m_client) }
+		{
+		}
+
+		PooledClient& PooledClient::operator=(PooledClient&& other) noexcept
+		{
+			if (this != &other) {
+				release();
+				m_anchor = std::move(other.m_anchor);
+				m_endpoint = std::move(other.m_endpoint);
+				m_client = std::move(other.m_client);
+			}
+			return *this;
+		}
+
+		void PooledClient::release() noexcept
+		{
+			if (m_anchor && m_client) {
+				//	the lock keeps the pool alive while the client is handed back
+				std::lock_guard<std::mutex> lock{ m_anchor->mutex };
+				if (m_anchor->pool != nullptr) {
+					m_anchor->pool->giveBack(m_endpoint, std::move(m_client));
+				}
+			}
+			m_client.reset();
+			m_anchor.reset();
+		}
+
+		ClientPool::ClientPool(ClientPoolConfig config /*= {}*/, ClientFactory factory /*= {}*/) :
+			m_config{ config },
+			m_factory{ std::move(factory) },
+			m_anchor{ std::make_shared<PoolAnchor>() }
+		{
+			m_anchor->pool = this;
+			if (!m_factory) {
+				m_factory = [](const std::string& ipAddr, int port) {
+					return std::unique_ptr<Client>(new Client{ ipAddr, port });
+				};
+			}
+		}
+
+		ClientPool::~ClientPool()
+		{
+			//	leases that are still out close their clients from now on
+			std::lock_guard<std::mutex> lock{ m_anchor->mutex };
+			m_anchor->pool = nullptr;
+		}
+
+		PooledClient ClientPool::acquire(const std::string& ipAddr, int port)
+		{
+			PooledClient lease;
+			lease.m_anchor = m_anchor;
+			lease.m_endpoint = makeEndpoint(ipAddr, port);
+
+			std::vector<std::unique_ptr<Client>> deadClients; // closed after the lock is released
+			{
+				std::lock_guard<std::mutex> lock{ m_mutex };
+				auto& idleList = m_idleClients[lease.m_endpoint];
+				evictIdle(idleList, std::chrono::steady_clock::now(), deadClients);
+
+				//	the most recently used client is the most likely one to be alive
+				while (!idleList.empty()) {
+					auto client = std::move(idleList.back().client);
+					idleList.pop_back();
+					if (client->isAlive()) {
+						lease.m_client = std::move(client);
+						break;
+					}
+					deadClients.push_back(std::move(client));
+				}
+			}
+
+			if (!lease.m_client) {
+				lease.m_client = connect(ipAddr, port);
+			}
+			return lease;
+		}
+
+		void ClientPool::prewarm(const std::string& ipAddr, int port, std::size_t count /*= 0*/)
+		{
+			const auto endpoint = makeEndpoint(ipAddr, port);
+			const auto target = (std::min)(count > 0 ? count : m_config.minIdle, m_config.maxIdle);
+
+			while (getIdleCount(ipAddr, port) < target) {
+				giveBack(endpoint, connect(ipAddr, port));
+			}
+		}
+
+		void ClientPool::evictIdle() noexcept
+		{
+			std::vector<std::unique_ptr<Client>> evictedClients; // closed after the lock is released
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			const auto now = std::chrono::steady_clock::now();
+			for (auto& endpoint : m_idleClients) {
+				evictIdle(endpoint.second, now, evictedClients);
+			}
+		}
+
+		std::size_t ClientPool::getIdleCount(const std::string& ipAddr, int port) const noexcept
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			const auto found = m_idleClients.find(makeEndpoint(ipAddr, port));
+			return found != m_idleClients.end() ? found->second.size() : 0;
+		}
+
+		std::string ClientPool::makeEndpoint(const std::string& ipAddr, int port)
+		{
+			return ipAddr + ':' + std::to_string(port);
+		}
+
+		std::unique_ptr<Client> ClientPool::connect(const std::string& ipAddr, int port)
+		{
+			auto client = m_factory(ipAddr, port);
+			client->connectServer();
+			return client;
+		}
+
+		void ClientPool::giveBack(const std::string& endpoint, std::unique_ptr<Client> client) noexcept
+		{
+			if (client->isConnectionAborted()) {
+				return;
+			}
+
+			try {
+				std::lock_guard<std::mutex> lock{ m_mutex };
+				auto& idleList = m_idleClients[endpoint];
+				if (idleList.size() < m_config.maxIdle) {
+					idleList.push_back(IdleClient{ std::move(client), std::chrono::steady_clock::now() });
+				}
+			}
+			catch (const std::bad_alloc&) {
+				// the client is closed instead
+			}
+		}
+
+		void ClientPool::evictIdle(IdleList& idleList, std::chrono::steady_clock::time_point now,
+			std::vector<std::unique_ptr<Client>>& evictedClients) noexcept
+		{
+			//	the oldest clients are at the front, the caller closes them without holding the lock
+			while (idleList.size() > m_config.minIdle && now - idleList.front().since >= m_config.idleTimeout) {
+				try {
+					evictedClients.push_back(std::move(idleList.front().client));
+				}
+				catch (const std::bad_alloc&) {
+					// the client is closed here instead
+				}
+				idleList.pop_front();
+			}
+		}
+	}
+}
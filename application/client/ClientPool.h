@@ -0,0 +1,184 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "Client.h"
+#include "network/SocketExport.h"
+
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace sdk {
+	namespace application {
+
+		class ClientPool; // forward declaration
+
+		// shared by a pool and its leases, the pool detaches itself when it is destroyed
+		struct PoolAnchor {
+			std::mutex mutex;
+			ClientPool* pool{};
+		};
+
+		struct ClientPoolConfig {
+			std::size_t minIdle{};									 // idle connections per endpoint that eviction keeps
+			std::size_t maxIdle{ 8 };								 // idle connections per endpoint, the surplus is closed
+			std::chrono::milliseconds idleTimeout{ std::chrono::seconds{ 60 } }; // idle connections older than it are evicted
+		};
+
+		// creates a client that is not connected yet, e.g. an SSLClient with its certificates
+		using ClientFactory = std::function<std::unique_ptr<Client>(const std::string& ipAddr, int port)>;
+
+		/**
+		 * @brief PooledClient class is a move only lease of a connected client.
+		 * @details The client goes back to its pool when the lease is destroyed. Call discard()
+		 *	if the connection is left in an unknown state, e.g. after an exception. A lease may
+		 *	outlive its pool, its client is closed then instead of handed back.
+		 */
+		class SOCKET_API PooledClient {
+		public:
+			PooledClient() noexcept = default;
+			~PooledClient();
+
+			PooledClient(PooledClient&& other) noexcept;
+			PooledClient& operator=(PooledClient&& other) noexcept;
+
+			// non copyable
+			PooledClient(const PooledClient&) = delete;
+			PooledClient& operator=(const PooledClient&) = delete;
+
+			Client* operator->() const noexcept
+			{
+				return m_client.get();
+			}
+
+			Client& operator*() const noexcept
+			{
+				return *m_client;
+			}
+
+			explicit operator bool() const noexcept
+			{
+				return m_client != nullptr;
+			}
+
+			/**
+			 * @brief Closes the connection instead of handing it back to the pool.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void discard() noexcept
+			{
+				m_client.reset();
+			}
+
+		private:
+			friend class ClientPool;
+
+			void release() noexcept;
+
+			std::shared_ptr<PoolAnchor> m_anchor;
+			std::string m_endpoint;
+			std::unique_ptr<Client> m_client;
+		};
+
+		/**
+		 * @brief ClientPool class keeps connected clients per endpoint to skip the TCP and TLS
+		 * handshakes of new connections.
+		 * @details An idle client is checked with Client::isAlive() before it is leased, dead ones
+		 *	are closed and replaced by a new connection. Idle clients above maxIdle are closed when
+		 *	they come back, the ones older than idleTimeout are evicted by evictIdle(), which also
+		 *	runs whenever an endpoint is used.
+		 */
+		class SOCKET_API ClientPool {
+		public:
+			explicit ClientPool(ClientPoolConfig config = {}, ClientFactory factory = {});
+			virtual ~ClientPool();
+
+			// non copyable
+			ClientPool(const ClientPool&) = delete;
+			ClientPool& operator=(const ClientPool&) = delete;
+
+			/**
+			 * @brief Leases an idle client of the endpoint or connects a new one.
+			 * @param ipAddr Ip address or host name of the server.
+			 * @param port Port number of the server.
+			 * @return The connected client.
+			 * @exception this function throws an SocketException if a new connection fails.
+			 */
+			NODISCARD PooledClient acquire(const std::string& ipAddr, int port);
+
+			/**
+			 * @brief Connects clients ahead of the first request.
+			 * @param ipAddr Ip address or host name of the server.
+			 * @param port Port number of the server.
+			 * @param count Idle client count to reach, 0 means minIdle.
+			 * @return nothing.
+			 * @exception this function throws an SocketException if a connection fails.
+			 */
+			void prewarm(const std::string& ipAddr, int port, std::size_t count = 0);
+
+			/**
+			 * @brief Closes the idle clients that exceed the idle timeout, minIdle clients per endpoint are kept.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void evictIdle() noexcept;
+
+			/**
+			 * @brief Gets the count of idle clients of an endpoint.
+			 * @param ipAddr Ip address or host name of the server.
+			 * @param port Port number of the server.
+			 * @return The count of idle clients.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD std::size_t getIdleCount(const std::string& ipAddr, int port) const noexcept;
+
+		private:
+			friend class PooledClient;
+
+			struct IdleClient {
+				std::unique_ptr<Client> client;
+				std::chrono::steady_clock::time_point since;
+			};
+
+			using IdleList = std::deque<IdleClient>;
+
+			static std::string makeEndpoint(const std::string& ipAddr, int port);
+			std::unique_ptr<Client> connect(const std::string& ipAddr, int port);
+			void giveBack(const std::string& endpoint, std::unique_ptr<Client> client) noexcept;
+			void evictIdle(IdleList& idleList, std::chrono::steady_clock::time_point now,
+				std::vector<std::unique_ptr<Client>>& evictedClients) noexcept;
+
+			ClientPoolConfig m_config;
+			ClientFactory m_factory;
+			std::shared_ptr<PoolAnchor> m_anchor;
+			mutable std::mutex m_mutex;
+			std::unordered_map<std::string, IdleList> m_idleClients;
+		};
+	}
+}
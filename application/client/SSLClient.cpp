@@ -86,6 +86,11 @@ namespace sdk {
 			return m_sslSocketDesc->read(message, maxSize);
 		}
 
+		bool SSLClient::isAlive() const noexcept
+		{
+			return m_sslSocketDesc && isSocketAlive(m_sslSocketDesc->getSocketId());
+		}
+
 #endif // OPENSSL_SUPPORTED
 	}
 }
\ No newline at end of file
@@ -49,6 +49,7 @@ namespace sdk {
 			NODISCARD int write(const std::vector<unsigned char>& msg) const override;
 			NODISCARD std::size_t read(std::vector<unsigned char>& responseMsg, int maxSize = 0) const override;
 			NODISCARD std::size_t read(std::string& message, int maxSize = 0) const override;
+			NODISCARD bool isAlive() const noexcept override;
 
 		private:
 			network::SSLSocket m_sslSocket;
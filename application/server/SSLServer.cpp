@@ -22,51 +22,49 @@
 
 #include "SSLServer.h"
 #include "network/SocketException.h"
-#include "network/SocketOption.h"
 
 #include <iostream>
+#include <vector>
 
 namespace sdk {
 	namespace application {
 
 #if OPENSSL_SUPPORTED
 
-		namespace {
-			constexpr const auto MAX_CLIENTS = 10;
-		}
-
 		SSLServer::SSLServer(int port, network::ProtocolType type, network::IpVersion ipVer) :
 			Server{ port, type, ipVer },
 			m_sslSocket{ port, network::ConnMethod::server, type, ipVer }
 		{
+			m_sslSocket.setCancellationToken(getCancellationToken());
 		}
 
 		void SSLServer::startListening()
 		{
-			network::SocketOption<network::SSLSocket> socketOpt{ m_sslSocket };
-			socketOpt.setBlockingMode(network::SocketOpt::ON); // non-blocking mode
-			socketOpt.setReuseAddr(network::SocketOpt::ON);
-
-			// bind and listen
-			m_sslSocket.bind();
-			m_sslSocket.listen(MAX_CLIENTS);
-
-			const std::string response{ "Hello from SSLServer!\n" };
-
-			while (!isAbortedListening()) {
-				try {
-					const SOCKET newSockId = m_sslSocket.accept();
+			const ListenerScope listenerScope{ *this };
+			prepareListener(m_sslSocket, false);
+			startWorkers();
+
+			std::vector<SOCKET> socketIds;
+			socketIds.reserve(getAcceptBatchSize());
+
+			//	the connection timer covers the handshake too
+			runAcceptLoop(m_sslSocket, [this, &socketIds](network::TimerWheel& timers) {
+				socketIds.clear();
+				(void)m_sslSocket.acceptBatch(socketIds, getAcceptBatchSize());
+				for (const auto newSockId : socketIds) {
 					auto sslSocketDesc = m_sslSocket.createSocketDescriptor(newSockId);
-					sslSocketDesc->accept();
-					std::string requestMsg;
-					sslSocketDesc->read(requestMsg);
-					std::cout << "Message recieved from client: " << requestMsg << "\n";
-					sslSocketDesc->write(response);
-				}
-				catch (const general::SocketException& ex) {
-					(void)ex;
+					armConnectionTimer(timers, sslSocketDesc);
+					dispatch([sslSocketDesc]() {
+						static const std::string response{ "Hello from SSLServer!\n" };
+
+						sslSocketDesc->accept();
+						std::string requestMsg;
+						(void)sslSocketDesc->read(requestMsg);
+						std::cout << "Message recieved from client: " << requestMsg << "\n";
+						(void)sslSocketDesc->write(response);
+					});
 				}
-			}
+			});
 		}
 
 		void SSLServer::loadServerCertificate(const char* certFile)
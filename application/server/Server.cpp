@@ -21,56 +21,318 @@
 // SOFTWARE.
 
 #include "Server.h"
+#include "network/Reactor.h"
 #include "network/SocketException.h"
 #include "network/SocketOption.h"
 
+#include <cerrno>
+#include <exception>
+#include <fstream>
 #include <iostream>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
 
 namespace sdk {
 	namespace application {
 
 		namespace {
-			constexpr const auto MAX_CLIENTS = 10;
+			//	pause of a listener that cannot accept because the process is out of resources
+			constexpr std::chrono::milliseconds ACCEPT_BACKOFF{ 100 };
+
+			//	a full descriptor table or memory does not go away by accepting again
+			bool isOutOfResources(int errorCode) noexcept
+			{
+#ifdef _WIN32
+				return errorCode == WSAEMFILE || errorCode == WSAENOBUFS;
+#else
+				return errorCode == EMFILE || errorCode == ENFILE || errorCode == ENOBUFS || errorCode == ENOMEM;
+#endif
+			}
+
+#ifdef __linux__
+			constexpr const auto NETSTAT_PATH = "/proc/net/netstat";
+
+			//	The file has a line of counter names followed by a line of values for each group.
+			void readListenCounters(ServerStats& stats)
+			{
+				std::ifstream netstat{ NETSTAT_PATH };
+				std::string names;
+				std::string values;
+				while (std::getline(netstat, names) && std::getline(netstat, values)) {
+					if (names.compare(0, 7, "TcpExt:") != 0) {
+						continue;
+					}
+
+					std::istringstream nameStream{ names };
+					std::istringstream valueStream{ values };
+					std::string name;
+					std::string value;
+					while (nameStream >> name && valueStream >> value) {
+						if (name == "ListenOverflows") {
+							stats.listenOverflows = std::stoull(value);
+						}
+						else if (name == "ListenDrops") {
+							stats.listenDrops = std::stoull(value);
+						}
+					}
+					break;
+				}
+			}
+#endif
 		}
 
 		Server::Server(int port,
 			network::ProtocolType type /*= ProtocolType::tcp*/,
 			network::IpVersion ipVer /*= IpVersion::IPv4*/) :
+			m_cancelToken{ std::make_shared<network::CancellationToken>() },
 			m_socket{ port, type, ipVer }
 		{
+			m_socket.setCancellationToken(m_cancelToken);
 		}
 
 		void Server::startListening()
 		{
-			network::SocketOption<network::Socket> socketOpt{ m_socket };
+			unsigned int shardCount = m_shardCount;
+			if (shardCount == 0) {
+				shardCount = std::thread::hardware_concurrency();
+			}
+
+			const ListenerScope listenerScope{ *this };
+			if (shardCount <= 1) {
+				prepareListener(m_socket, false);
+				startWorkers();
+				acceptLoop(m_socket);
+				return;
+			}
+
+			// The first shard is our own socket, the others are created with the same parameters.
+			// They are members, so getStats() never queries a closed socket.
+			prepareListener(m_socket, true);
+			for (unsigned int i = 1; i < shardCount; ++i) {
+				std::unique_ptr<network::Socket> shard{ new network::Socket{ m_socket.getPort(),
+					m_socket.getProtocolType(), m_socket.getIpVersion() } };
+				shard->setCancellationToken(m_cancelToken);
+				prepareListener(*shard, true);
+				m_shards.push_back(std::move(shard));
+			}
+
+			startWorkers();
+
+			//	A failing accept loop stops the others, its error is thrown once they are joined.
+			std::vector<std::exception_ptr> errors(m_shards.size() + 1);
+			std::vector<std::thread> threads;
+			threads.reserve(m_shards.size());
+			for (std::size_t i = 0; i < m_shards.size(); ++i) {
+				auto* shardPtr = m_shards[i].get();
+				threads.emplace_back([this, shardPtr, &errors, i]() {
+					try {
+						acceptLoop(*shardPtr);
+					}
+					catch (...) {
+						errors[i + 1] = std::current_exception();
+						abortListening();
+					}
+				});
+			}
+
+			try {
+				acceptLoop(m_socket);
+			}
+			catch (...) {
+				errors[0] = std::current_exception();
+				abortListening();
+			}
+
+			for (auto& thread : threads) {
+				thread.join();
+			}
+
+			// the scope waits for the handlers before the shards are closed.
+			for (const auto& error : errors) {
+				if (error) {
+					std::rethrow_exception(error);
+				}
+			}
+		}
+
+		void Server::prepareListener(network::Socket& socket, bool reusePort)
+		{
+			network::SocketOption<network::Socket> socketOpt{ socket };
 			socketOpt.setBlockingMode(network::SocketOpt::ON); // non-blocking mode
 			socketOpt.setReuseAddr(network::SocketOpt::ON);
+			if (reusePort) {
+				socketOpt.setReusePort(network::SocketOpt::ON);
+			}
+
+			if (m_fastOpenQueueLength > 0) {
+				socketOpt.setFastOpen(m_fastOpenQueueLength);
+			}
 
 			// bind and listen
-			m_socket.bind();
-			m_socket.listen(MAX_CLIENTS);
+			socket.bind();
+			if (m_deferAccept.count() > 0) {
+				socketOpt.setDeferAccept(static_cast<int>(m_deferAccept.count()));
+			}
+			socket.listen(m_backlog);
 
-			const std::string response{ "Hello from Server!\n" };
+			std::lock_guard<std::mutex> lock{ m_listenerMutex };
+			m_listenerIds.push_back(socket.getSocketId());
+		}
 
-			while (!m_abortListening) {
+		void Server::clearListeners() noexcept
+		{
+			std::lock_guard<std::mutex> lock{ m_listenerMutex };
+			m_listenerIds.clear();
+			m_shards.clear();
+		}
+
+		ServerStats Server::getStats() const noexcept
+		{
+			ServerStats stats;
+#ifdef __linux__
+			{
+				std::lock_guard<std::mutex> lock{ m_listenerMutex };
+				for (const auto listenerId : m_listenerIds) {
+					struct tcp_info info{};
+					socklen_t infoSize = sizeof(info);
+					if (getsockopt(static_cast<int>(listenerId), IPPROTO_TCP, TCP_INFO, &info, &infoSize) == 0 &&
+						info.tcpi_state == TCP_LISTEN) {
+						// for a listening socket these fields hold the accept queue
+						stats.acceptQueueLength += info.tcpi_unacked;
+						stats.acceptQueueLimit += info.tcpi_sacked;
+					}
+				}
+			}
+
+			try {
+				readListenCounters(stats);
+			}
+			catch (const std::exception& ex) {
+				(void)ex; // a malformed file leaves the counters at 0
+			}
+#endif
+			return stats;
+		}
+
+		void Server::acceptLoop(network::Socket& socket)
+		{
+			std::vector<SOCKET> socketIds;
+			socketIds.reserve(m_acceptBatchSize);
+
+			runAcceptLoop(socket, [this, &socket, &socketIds](network::TimerWheel& timers) {
+				socketIds.clear();
+				(void)socket.acceptBatch(socketIds, m_acceptBatchSize);
+				for (const auto newSockId : socketIds) {
+					auto socketDesc = socket.createSocketDescriptor(newSockId);
+					armConnectionTimer(timers, socketDesc);
+					dispatch([this, socketDesc]() {
+						handleClient(*socketDesc);
+					});
+				}
+			});
+		}
+
+		void Server::runAcceptLoop(network::Socket& socket, const std::function<void(network::TimerWheel&)>& acceptConnection)
+		{
+			network::Reactor reactor;
+			const auto listenerId = socket.getSocketId();
+			reactor.add(listenerId, network::EVENT_READ, [&reactor, &acceptConnection, listenerId](SOCKET, std::uint32_t) {
 				try {
-					const SOCKET newSockId = m_socket.accept();
-					auto socketDesc = m_socket.createSocketDescriptor(newSockId);
-					std::string requestMsg;
-					if (socketDesc->read(requestMsg) > 0) {
-						std::cout << "Message recieved from client: " << requestMsg << "\n";
-						(void)socketDesc->write(response);
+					acceptConnection(reactor.getTimers());
+				}
+				catch (const general::SocketException& ex) {
+					if (!isOutOfResources(ex.getErrorCode())) {
+						return;
 					}
+
+					//	The pending connection keeps the listener readable, so it is paused for a while
+					//	instead of failing on the same error in a busy loop.
+					reactor.modify(listenerId, network::EVENT_NONE);
+					(void)reactor.getTimers().schedule(ACCEPT_BACKOFF, [&reactor, listenerId]() {
+						reactor.modify(listenerId, network::EVENT_READ);
+					});
+				}
+			});
+
+			//	The token only wakes up the wait, abortListening() sets the flag before cancelling.
+			reactor.add(m_cancelToken->getWaitHandle(), network::EVENT_READ, [](SOCKET, std::uint32_t) {});
+
+			while (!m_abortListening) {
+				(void)reactor.runOnce(-1);
+			}
+		}
+
+		void Server::armConnectionTimer(network::TimerWheel& timers, const std::shared_ptr<network::SocketDescriptor>& socketDesc)
+		{
+			//	a handler without workers has finished before the accept loop fires timers again
+			if (m_connectionTimeout.count() <= 0 || !m_threadPool) {
+				return;
+			}
+
+			//	The handler runs on a worker and the wheel belongs to the accept loop, so the timer
+			//	is not cancelled when the handler finishes. It finds the descriptor released instead.
+			const std::weak_ptr<network::SocketDescriptor> weakDesc{ socketDesc };
+			(void)timers.schedule(m_connectionTimeout, [weakDesc]() {
+				if (const auto expiredDesc = weakDesc.lock()) {
+					// wakes up the blocked handler, the descriptor closes the socket
+					shutdown(expiredDesc->getSocketId(), SD_BOTH);
+				}
+			});
+		}
+
+		void Server::handleClient(network::SocketDescriptor& socketDesc)
+		{
+			static const std::string response{ "Hello from Server!\n" };
+
+			std::string requestMsg;
+			if (socketDesc.read(requestMsg) > 0) {
+				std::cout << "Message recieved from client: " << requestMsg << "\n";
+				(void)socketDesc.write(response);
+			}
+		}
+
+		void Server::startWorkers()
+		{
+			if (m_workerCount > 0) {
+				m_threadPool.reset(new ThreadPool{ m_workerCount });
+			}
+		}
+
+		void Server::stopWorkers() noexcept
+		{
+			m_threadPool.reset();
+		}
+
+		void Server::dispatch(std::function<void()> handler)
+		{
+			auto task = [handler]() {
+				try {
+					handler();
 				}
 				catch (const general::SocketException& ex) {
 					(void)ex;
 				}
+			};
+
+			if (m_threadPool) {
+				m_threadPool->submit(std::move(task));
+			}
+			else {
+				task();
 			}
 		}
 
 		void Server::abortListening() noexcept
 		{
 			m_abortListening = true;
+			m_cancelToken->cancel(); // wakes up the accept loops
 		}
 	}
 }
@@ -24,10 +24,31 @@
 #include "network/Socket.h"
 #include "network/SocketDescriptor.h"
 #include "network/SocketExport.h"
+#include "network/TimerWheel.h"
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace sdk {
 	namespace application {
 
+		/**
+		 * @brief Accept queue statistics of a server. The counters are only collected on Linux,
+		 *	they are 0 on other platforms.
+		 */
+		struct ServerStats {
+			std::uint32_t acceptQueueLength{}; // connections waiting in the accept queues of the listeners
+			std::uint32_t acceptQueueLimit{};  // sum of the backlogs that the kernel applies to the listeners
+			std::uint64_t listenOverflows{};   // times an accept queue was full, for the whole network namespace
+			std::uint64_t listenDrops{};	   // connection requests dropped by listeners, for the whole network namespace
+		};
+
 		class SOCKET_API Server {
 		public:
 			Server(int port, network::ProtocolType type = network::ProtocolType::tcp,
@@ -45,9 +66,218 @@ namespace sdk {
 				return m_abortListening;
 			}
 
+			/**
+			 * @brief Sets the number of listening sockets. Each one is bound with SO_REUSEPORT
+			 * and runs its own accept loop on a separate thread, so the kernel load-balances
+			 * new connections across them. It must be called before startListening().
+			 * @param shardCount The number of listening sockets, 0 means one per hardware thread.
+			 * Default is 1, a single listening socket on the calling thread.
+			 * @return nothing.
+			 */
+			void setShardCount(unsigned int shardCount) noexcept
+			{
+				m_shardCount = shardCount;
+			}
+
+			/**
+			 * @brief Sets the number of workers that handle accepted connections, so that a slow
+			 * client does not block the accept loop. It must be called before startListening().
+			 * @param workerCount The number of workers. Default is 0, connections are handled
+			 * on the accepting thread.
+			 * @return nothing.
+			 */
+			void setWorkerCount(unsigned int workerCount) noexcept
+			{
+				m_workerCount = workerCount;
+			}
+
+			/**
+			 * @brief Sets how long an accepted connection may stay open in total, the connection is shut
+			 * down when its handler has not finished by then, whether it is idle or not. The deadlines of
+			 * all connections are kept in the timer wheel of the accept loop, so they do not need a sleeping
+			 * wait each. It needs workers (setWorkerCount()): without them the handler runs on the accept
+			 * loop, which cannot fire timers meanwhile. It must be called before startListening().
+			 * @param connectionTimeout The timeout. Default is 0, connections are not timed out.
+			 * @return nothing.
+			 */
+			void setConnectionTimeout(std::chrono::milliseconds connectionTimeout) noexcept
+			{
+				m_connectionTimeout = connectionTimeout;
+			}
+
+			/**
+			 * @brief Sets how many pending connections are accepted on each wake up of the accept loop.
+			 * The accepted sockets are non-blocking. It must be called before startListening().
+			 * @param acceptBatchSize Maximum count of connections per wake up, it is at least 1.
+			 * Default is DEFAULT_ACCEPT_BATCH.
+			 * @return nothing.
+			 */
+			void setAcceptBatchSize(std::size_t acceptBatchSize) noexcept
+			{
+				m_acceptBatchSize = acceptBatchSize > 0 ? acceptBatchSize : 1;
+			}
+
+			/**
+			 * @brief Sets the length of the accept queue of each listening socket. The kernel may cap it
+			 * (net.core.somaxconn on Linux). It must be called before startListening().
+			 * @param backlog The backlog. Default is SOMAXCONN.
+			 * @return nothing.
+			 */
+			void setBacklog(int backlog) noexcept
+			{
+				m_backlog = backlog;
+			}
+
+			/**
+			 * @brief Lets the listening sockets report a connection only when its first data arrives
+			 * (TCP_DEFER_ACCEPT), so the accept loop does not wake up for idle connections. It is only
+			 * supported on Linux. It must be called before startListening().
+			 * @param deferAccept How long the kernel waits for the data. Default is 0, disabled.
+			 * @return nothing.
+			 */
+			void setDeferAccept(std::chrono::seconds deferAccept) noexcept
+			{
+				m_deferAccept = deferAccept;
+			}
+
+			/**
+			 * @brief Allows the clients to send data in the SYN of a connection (TCP_FASTOPEN).
+			 * It must be called before startListening().
+			 * @param queueLength Maximum count of pending fast open requests per listening socket.
+			 * Default is 0, disabled.
+			 * @return nothing.
+			 */
+			void setFastOpenQueueLength(int queueLength) noexcept
+			{
+				m_fastOpenQueueLength = queueLength;
+			}
+
+			/**
+			 * @brief Gets the accept queue statistics of the listening sockets. It is safe to call
+			 * from any thread while the server is listening.
+			 * @return The statistics.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD ServerStats getStats() const noexcept;
+
+		protected:
+			/**
+			 * @brief Applies the listener options of the server, then binds and listens the socket.
+			 * The socket is reported by getStats() until the server stops listening.
+			 * @param socket The listening socket.
+			 * @param reusePort Binds the socket with SO_REUSEPORT.
+			 * @return nothing.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			void prepareListener(network::Socket& socket, bool reusePort);
+
+			/**
+			 * @brief Stops reporting the listening sockets, it must be called before they are closed.
+			 * @return nothing.
+			 */
+			void clearListeners() noexcept;
+
+			/**
+			 * @brief Stops the workers and the reporting of the listening sockets when startListening()
+			 * returns or throws. The handlers may still use the sockets, so the workers are stopped first.
+			 */
+			class ListenerScope {
+			public:
+				explicit ListenerScope(Server& server) noexcept :
+					m_server(server)
+				{
+				}
+
+				~ListenerScope()
+				{
+					m_server.stopWorkers();
+					m_server.clearListeners();
+				}
+
+				// non copyable
+				ListenerScope(const ListenerScope&) = delete;
+				ListenerScope& operator=(const ListenerScope&) = delete;
+
+			private:
+				Server& m_server;
+			};
+
+			/**
+			 * @brief Gets the token that abortListening() cancels. Listening sockets share it, so an
+			 * idle accept wakes up only for a new connection or the abort.
+			 * @return The cancellation token.
+			 * @exception This function never throws an exception.
+			 */
+			const std::shared_ptr<network::CancellationToken>& getCancellationToken() const noexcept
+			{
+				return m_cancelToken;
+			}
+
+			/**
+			 * @brief Creates the worker pool if a worker count is set.
+			 * @return nothing.
+			 */
+			void startWorkers();
+
+			/**
+			 * @brief Waits for the queued handlers and destroys the worker pool.
+			 * @return nothing.
+			 */
+			void stopWorkers() noexcept;
+
+			/**
+			 * @brief Runs a connection handler on the worker pool, or on the calling thread
+			 * if there is no worker pool. SocketExceptions thrown by the handler are ignored.
+			 * @param handler The connection handler.
+			 * @return nothing.
+			 */
+			void dispatch(std::function<void()> handler);
+
+			/**
+			 * @brief Runs the accept loop of a listening socket on the calling thread until
+			 * abortListening() is called. The loop waits on a reactor that also fires the connection timers.
+			 * @param socket The listening socket.
+			 * @param acceptConnection The function that accepts and dispatches the pending connections,
+			 * it receives the timers of the loop. SocketExceptions thrown by it are ignored, the listener is
+			 * paused for a while if the process is out of descriptors or memory.
+			 * @return nothing.
+			 * @exception this function throws an SocketException if the reactor fails.
+			 */
+			void runAcceptLoop(network::Socket& socket, const std::function<void(network::TimerWheel&)>& acceptConnection);
+
+			/**
+			 * @brief Arms the timer of an accepted connection if a connection timeout is set and workers
+			 * handle the connections. The timer does not keep the descriptor alive and does nothing if it is
+			 * already released.
+			 * @param timers The timers of the accept loop.
+			 * @param socketDesc The accepted connection.
+			 * @return nothing.
+			 */
+			void armConnectionTimer(network::TimerWheel& timers, const std::shared_ptr<network::SocketDescriptor>& socketDesc);
+
+			NODISCARD std::size_t getAcceptBatchSize() const noexcept
+			{
+				return m_acceptBatchSize;
+			}
+
 		private:
-			bool m_abortListening{};
+			void acceptLoop(network::Socket& socket);
+			void handleClient(network::SocketDescriptor& socketDesc);
+
+			std::atomic<bool> m_abortListening{};
+			std::shared_ptr<network::CancellationToken> m_cancelToken;
+			unsigned int m_shardCount{ 1 };
+			unsigned int m_workerCount{};
+			std::chrono::milliseconds m_connectionTimeout{};
+			std::size_t m_acceptBatchSize{ network::DEFAULT_ACCEPT_BATCH };
+			int m_backlog{ SOMAXCONN };
+			std::chrono::seconds m_deferAccept{};
+			int m_fastOpenQueueLength{};
+			mutable std::mutex m_listenerMutex;
+			std::vector<SOCKET> m_listenerIds; // listening sockets reported by getStats()
+			std::vector<std::unique_ptr<network::Socket>> m_shards; // listening sockets other than m_socket
 			network::Socket m_socket;
+			std::unique_ptr<ThreadPool> m_threadPool; // destroyed before the socket
 		};
 
 	};
@@ -0,0 +1,162 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "ThreadPool.h"
+
+namespace sdk {
+	namespace application {
+
+		namespace {
+			// The pool and the index of the worker that runs on the current thread.
+			thread_local const ThreadPool* currentPool = nullptr;
+			thread_local std::size_t currentWorker = 0;
+		}
+
+		ThreadPool::ThreadPool(unsigned int workerCount)
+		{
+			if (workerCount == 0) {
+				workerCount = std::thread::hardware_concurrency();
+			}
+			if (workerCount == 0) {
+				workerCount = 1;
+			}
+
+			m_workers.reserve(workerCount);
+			for (unsigned int i = 0; i < workerCount; ++i) {
+				m_workers.emplace_back(new Worker{});
+			}
+
+			try {
+				m_threads.reserve(workerCount);
+				for (std::size_t i = 0; i < workerCount; ++i) {
+					m_threads.emplace_back(&ThreadPool::workerLoop, this, i);
+				}
+			}
+			catch (...) {
+				// the destructor is not called, joinable threads would terminate the process.
+				stop();
+				throw;
+			}
+		}
+
+		ThreadPool::~ThreadPool()
+		{
+			stop();
+		}
+
+		void ThreadPool::stop() noexcept
+		{
+			{
+				const std::lock_guard<std::mutex> lock{ m_waitLock };
+				m_stopping = true;
+			}
+			m_waitCond.notify_all();
+
+			for (auto& thread : m_threads) {
+				thread.join();
+			}
+		}
+
+		void ThreadPool::submit(Task task)
+		{
+			// A worker keeps the tasks it creates, others are distributed in round-robin order.
+			const std::size_t index = (currentPool == this) ?
+				currentWorker :
+				m_nextWorker.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+
+			// count the task first, so that a worker never sees more tasks than the counter.
+			m_pendingTasks.fetch_add(1);
+
+			{
+				auto& worker = *m_workers[index];
+				const std::lock_guard<std::mutex> lock{ worker.lock };
+				worker.tasks.push_back(std::move(task));
+			}
+
+			// A worker counts itself as sleeping before it checks the counter under the lock,
+			// so either it sees the task or we see it and wait until it sleeps.
+			if (m_sleepingWorkers.load() > 0) {
+				const std::lock_guard<std::mutex> lock{ m_waitLock };
+				m_waitCond.notify_one();
+			}
+		}
+
+		void ThreadPool::workerLoop(std::size_t index)
+		{
+			currentPool = this;
+			currentWorker = index;
+
+			while (true) {
+				Task task;
+				if (popTask(index, task) || stealTask(index, task)) {
+					m_pendingTasks.fetch_sub(1);
+
+					try {
+						task();
+					}
+					catch (...) {
+						// a failing handler must not terminate the worker
+					}
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock{ m_waitLock };
+				m_sleepingWorkers.fetch_add(1);
+				m_waitCond.wait(lock, [this]() {
+					return m_stopping || m_pendingTasks > 0;
+				});
+				m_sleepingWorkers.fetch_sub(1);
+
+				if (m_stopping && m_pendingTasks == 0) {
+					break;
+				}
+			}
+		}
+
+		bool ThreadPool::popTask(std::size_t index, Task& task)
+		{
+			auto& worker = *m_workers[index];
+			const std::lock_guard<std::mutex> lock{ worker.lock };
+			if (worker.tasks.empty()) {
+				return false;
+			}
+
+			task = std::move(worker.tasks.back());
+			worker.tasks.pop_back();
+			return true;
+		}
+
+		bool ThreadPool::stealTask(std::size_t index, Task& task)
+		{
+			for (std::size_t i = 1; i < m_workers.size(); ++i) {
+				auto& victim = *m_workers[(index + i) % m_workers.size()];
+				const std::lock_guard<std::mutex> lock{ victim.lock };
+				if (!victim.tasks.empty()) {
+					task = std::move(victim.tasks.front());
+					victim.tasks.pop_front();
+					return true;
+				}
+			}
+			return false;
+		}
+	}
+}
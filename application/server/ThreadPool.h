@@ -0,0 +1,105 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+#include "network/SocketExport.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace sdk {
+	namespace application {
+
+		/**
+		 * @brief ThreadPool class is a work-stealing executor for connection handlers.
+		 * @details Every worker has its own task queue. Tasks submitted by a worker go to its own queue,
+		 *	other tasks are distributed to the queues in round-robin order. A worker runs the newest task
+		 *	of its queue first, while its data is still in the cache. A worker that runs out of tasks steals
+		 *	the oldest task of the other queues before it goes to sleep.
+		 */
+		class SOCKET_API ThreadPool {
+		public:
+			using Task = std::function<void()>;
+
+			/**
+			 * @brief Creates the workers of the pool.
+			 * @param workerCount The number of workers, 0 means one per hardware thread.
+			 * @exception this function throws an std::system_error if a worker thread cannot be created,
+			 * the workers that are already started are joined.
+			 */
+			explicit ThreadPool(unsigned int workerCount);
+
+			/**
+			 * @brief Runs the queued tasks and joins the workers.
+			 */
+			~ThreadPool();
+
+			// non copyable
+			ThreadPool(const ThreadPool&) = delete;
+			ThreadPool& operator=(const ThreadPool&) = delete;
+
+			/**
+			 * @brief Queues a task to be run by a worker.
+			 * @param task The task.
+			 * @return nothing.
+			 */
+			void submit(Task task);
+
+			/**
+			 * @brief Gets the number of workers.
+			 * @return The number of workers.
+			 * @exception This function never throws an exception.
+			 */
+			unsigned int getWorkerCount() const noexcept
+			{
+				return static_cast<unsigned int>(m_workers.size());
+			}
+
+		private:
+			struct Worker {
+				std::mutex lock;
+				std::deque<Task> tasks;
+			};
+
+			void stop() noexcept;
+			void workerLoop(std::size_t index);
+			bool popTask(std::size_t index, Task& task);
+			bool stealTask(std::size_t index, Task& task);
+
+			std::vector<std::unique_ptr<Worker>> m_workers;
+			std::vector<std::thread> m_threads;
+			// the workers only take the lock to sleep, and the submitters only to wake up a sleeping worker.
+			std::mutex m_waitLock;
+			std::condition_variable m_waitCond;
+			std::atomic<std::size_t> m_pendingTasks{};
+			std::atomic<std::size_t> m_sleepingWorkers{};
+			std::atomic<std::size_t> m_nextWorker{};
+			bool m_stopping{}; // guarded by m_waitLock
+		};
+	}
+}
@@ -0,0 +1,303 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "BufferPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace sdk {
+	namespace network {
+
+		namespace {
+			constexpr const std::size_t UNPOOLED_CLASS = ~static_cast<std::size_t>(0);
+			constexpr const std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+			constexpr const std::size_t BUFFERS_PER_SLAB = 16;
+
+			std::atomic<std::uint64_t> nextPoolId{ 1 };
+		}
+
+		struct BufferPoolState {
+			struct Slab {
+				char* memory;
+				std::size_t size;
+				bool mapped;
+			};
+
+			~BufferPoolState()
+			{
+				for (const auto& slab : slabs) {
+#ifdef __linux__
+					if (slab.mapped) {
+						munmap(slab.memory, slab.size);
+						continue;
+					}
+#endif
+					delete[] slab.memory;
+				}
+			}
+
+			// carves a new slab into the central free list of the class, the caller holds the mutex.
+			void growClass(std::size_t classIndex)
+			{
+				const auto bufferSize = classSizes[classIndex];
+				auto slabSize = bufferSize * BUFFERS_PER_SLAB;
+#ifdef __linux__
+				if (hugePages) {
+					slabSize = ((slabSize + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE) * HUGE_PAGE_SIZE;
+				}
+#endif
+				// reserve first, so nothing can throw after the slab is allocated
+				auto& freeList = centralLists[classIndex];
+				freeList.reserve(freeList.size() + slabSize / bufferSize);
+				slabs.reserve(slabs.size() + 1);
+
+				Slab slab{ nullptr, slabSize, false };
+#ifdef __linux__
+				if (hugePages) {
+					void* memory = mmap(nullptr, slabSize, PROT_READ | PROT_WRITE,
+						MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+					if (memory == MAP_FAILED) {
+						// no reserved huge pages, ask for transparent huge pages instead
+						memory = mmap(nullptr, slabSize, PROT_READ | PROT_WRITE,
+							MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+						if (memory == MAP_FAILED) {
+							throw std::bad_alloc{};
+						}
+#ifdef MADV_HUGEPAGE
+						(void)madvise(memory, slabSize, MADV_HUGEPAGE);
+#endif
+					}
+					slab.memory = static_cast<char*>(memory);
+					slab.mapped = true;
+				}
+#endif
+				if (slab.memory == nullptr) {
+					slab.memory = new char[slabSize];
+				}
+
+				for (std::size_t offset = 0; offset + bufferSize <= slabSize; offset += bufferSize) {
+					freeList.push_back(slab.memory + offset);
+				}
+				slabs.push_back(slab);
+			}
+
+			std::uint64_t id{};
+			std::vector<std::size_t> classSizes;
+			bool hugePages{};
+			std::size_t threadCacheSize{};
+
+			std::mutex mutex;
+			std::vector<std::vector<char*>> centralLists;
+			std::vector<Slab> slabs;
+		};
+
+		namespace {
+			//	Free lists of the pools that are used by a thread. The buffers of a destroyed
+			//	pool are never touched again since its memory is already released.
+			class ThreadCache {
+			public:
+				struct Entry {
+					std::uint64_t poolId;
+					std::weak_ptr<BufferPoolState> state;
+					std::vector<std::vector<char*>> freeLists;
+				};
+
+				~ThreadCache()
+				{
+					for (auto& entry : m_entries) {
+						if (const auto state = entry.state.lock()) {
+							const std::lock_guard<std::mutex> lock{ state->mutex };
+							for (std::size_t i = 0; i < entry.freeLists.size(); ++i) {
+								auto& central = state->centralLists[i];
+								central.insert(central.end(), entry.freeLists[i].begin(), entry.freeLists[i].end());
+							}
+						}
+					}
+				}
+
+				std::vector<std::vector<char*>>& freeLists(const std::shared_ptr<BufferPoolState>& state)
+				{
+					for (auto& entry : m_entries) {
+						if (entry.poolId == state->id) {
+							return entry.freeLists;
+						}
+					}
+
+					m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(), [](const Entry& entry) {
+						return entry.state.expired();
+					}),
+						m_entries.end());
+					m_entries.push_back(Entry{ state->id, state, std::vector<std::vector<char*>>(state->classSizes.size()) });
+					return m_entries.back().freeLists;
+				}
+
+				std::vector<std::vector<char*>>* findFreeLists(std::uint64_t poolId) noexcept
+				{
+					for (auto& entry : m_entries) {
+						if (entry.poolId == poolId) {
+							return &entry.freeLists;
+						}
+					}
+					return nullptr;
+				}
+
+			private:
+				std::vector<Entry> m_entries;
+			};
+
+			thread_local ThreadCache threadCache;
+		}
+
+		PooledBuffer::~PooledBuffer()
+		{
+			release();
+		}
+
+		PooledBuffer::PooledBuffer(PooledBuffer&& other) noexcept :
+			m_state{ std::move(other.m_state) },
+			m_data{ other.m_data },
+			m_size{ other.m_size },
+			m_capacity{ other.m_capacity },
+			m_classIndex{ other.m_classIndex }
+		{
+			other.m_data = nullptr;
+			other.m_size = 0;
+			other.m_capacity = 0;
+		}
+
+		PooledBuffer& PooledBuffer::operator=(PooledBuffer&& other) noexcept
+		{
+			if (this != &other) {
+				release();
+				m_state = std::move(other.m_state);
+				m_data = other.m_data;
+				m_size = other.m_size;
+				m_capacity = other.m_capacity;
+				m_classIndex = other.m_classIndex;
+				other.m_data = nullptr;
+				other.m_size = 0;
+				other.m_capacity = 0;
+			}
+			return *this;
+		}
+
+		void PooledBuffer::release() noexcept
+		{
+			if (m_data == nullptr) {
+				return;
+			}
+
+			if (m_classIndex == UNPOOLED_CLASS) {
+				delete[] m_data;
+			}
+			else {
+				BufferPool::recycle(*m_state, m_classIndex, m_data);
+			}
+
+			m_state.reset();
+			m_data = nullptr;
+			m_size = 0;
+			m_capacity = 0;
+		}
+
+		BufferPool::BufferPool(std::vector<std::size_t> bufferClasses /*= { 2048, 8192, 65536 }*/,
+			bool hugePages /*= false*/, std::size_t threadCacheSize /*= 64*/) :
+			m_state{ std::make_shared<BufferPoolState>() }
+		{
+			bufferClasses.erase(std::remove(bufferClasses.begin(), bufferClasses.end(), 0), bufferClasses.end());
+			std::sort(bufferClasses.begin(), bufferClasses.end());
+			bufferClasses.erase(std::unique(bufferClasses.begin(), bufferClasses.end()), bufferClasses.end());
+
+			m_state->id = nextPoolId++;
+			m_state->centralLists.resize(bufferClasses.size());
+			m_state->classSizes = std::move(bufferClasses);
+			m_state->hugePages = hugePages;
+			m_state->threadCacheSize = (std::max)(threadCacheSize, static_cast<std::size_t>(1));
+		}
+
+		PooledBuffer BufferPool::acquire(std::size_t minSize)
+		{
+			PooledBuffer buffer;
+
+			const auto& classSizes = m_state->classSizes;
+			const auto iter = std::lower_bound(classSizes.begin(), classSizes.end(), minSize);
+			if (iter == classSizes.end()) {
+				buffer.m_data = new char[minSize];
+				buffer.m_capacity = minSize;
+				buffer.m_classIndex = UNPOOLED_CLASS;
+				return buffer;
+			}
+
+			const auto classIndex = static_cast<std::size_t>(iter - classSizes.begin());
+			auto& freeList = threadCache.freeLists(m_state)[classIndex];
+			if (freeList.empty()) {
+				// refill half of the thread cache at once to keep the lock rare
+				const std::lock_guard<std::mutex> lock{ m_state->mutex };
+				auto& central = m_state->centralLists[classIndex];
+				if (central.empty()) {
+					m_state->growClass(classIndex);
+				}
+				const auto count = (std::min)(central.size(), (m_state->threadCacheSize + 1) / 2);
+				freeList.insert(freeList.end(), central.end() - static_cast<std::ptrdiff_t>(count), central.end());
+				central.resize(central.size() - count);
+			}
+
+			buffer.m_state = m_state;
+			buffer.m_data = freeList.back();
+			buffer.m_capacity = *iter;
+			buffer.m_classIndex = classIndex;
+			freeList.pop_back();
+			return buffer;
+		}
+
+		void BufferPool::recycle(BufferPoolState& state, std::size_t classIndex, char* data) noexcept
+		{
+			auto* freeLists = threadCache.findFreeLists(state.id);
+			if (freeLists != nullptr && (*freeLists)[classIndex].size() < state.threadCacheSize) {
+				(*freeLists)[classIndex].push_back(data);
+				return;
+			}
+
+			// the thread cache is full or the thread never used this pool
+			const std::lock_guard<std::mutex> lock{ state.mutex };
+			try {
+				state.centralLists[classIndex].push_back(data);
+			}
+			catch (const std::bad_alloc&) {
+				// the buffer is unreachable until the pool is destroyed, its slab still owns it
+			}
+		}
+
+		BufferPool& BufferPool::defaultPool()
+		{
+			static BufferPool pool;
+			return pool;
+		}
+	}
+}
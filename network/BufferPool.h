@@ -0,0 +1,165 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include "SocketExport.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace sdk {
+	namespace network {
+
+		class BufferPool; // forward declaration
+		struct BufferPoolState; // forward declaration
+
+		/**
+		 * @brief PooledBuffer class is a move only handle of a buffer that belongs to a BufferPool.
+		 * @details The buffer is handed back to its pool when the handle is destroyed or release()
+		 *	is called. It may be released on another thread than the one that acquired it.
+		 */
+		class SOCKET_API PooledBuffer {
+		public:
+			PooledBuffer() noexcept = default;
+			~PooledBuffer();
+
+			PooledBuffer(PooledBuffer&& other) noexcept;
+			PooledBuffer& operator=(PooledBuffer&& other) noexcept;
+
+			// non copyable
+			PooledBuffer(const PooledBuffer&) = delete;
+			PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+			NODISCARD char* data() noexcept
+			{
+				return m_data;
+			}
+
+			NODISCARD const char* data() const noexcept
+			{
+				return m_data;
+			}
+
+			/**
+			 * @brief Gets the count of valid bytes in the buffer.
+			 * @return The count of valid bytes.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD std::size_t size() const noexcept
+			{
+				return m_size;
+			}
+
+			/**
+			 * @brief Sets the count of valid bytes in the buffer. It is clamped to the capacity.
+			 * @param size The count of valid bytes.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void setSize(std::size_t size) noexcept
+			{
+				m_size = size < m_capacity ? size : m_capacity;
+			}
+
+			NODISCARD std::size_t capacity() const noexcept
+			{
+				return m_capacity;
+			}
+
+			NODISCARD bool empty() const noexcept
+			{
+				return m_size == 0;
+			}
+
+			/**
+			 * @brief Hands the buffer back to its pool, the handle becomes empty.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void release() noexcept;
+
+		private:
+			friend class BufferPool;
+
+			std::shared_ptr<BufferPoolState> m_state;
+			char* m_data{};
+			std::size_t m_size{};
+			std::size_t m_capacity{};
+			std::size_t m_classIndex{};
+		};
+
+		/**
+		 * @brief BufferPool class recycles receive buffers to avoid allocation churn.
+		 * @details Buffers are grouped in size classes. Every thread keeps its own free lists,
+		 *	so acquiring and releasing a buffer does not lock in the common case. The memory is
+		 *	carved from slabs that are optionally backed by huge pages (Linux only) and it is
+		 *	returned to the system when the pool and all of its buffers are destroyed.
+		 */
+		class SOCKET_API BufferPool {
+		public:
+			/**
+			 * @brief Creates a buffer pool.
+			 * @param bufferClasses Buffer sizes of the pool in bytes.
+			 * @param hugePages Back the slabs by huge pages if the system allows.
+			 * @param threadCacheSize Maximum count of free buffers a thread keeps per class.
+			 * @exception This function throws std::bad_alloc if the memory cannot be allocated.
+			 */
+			explicit BufferPool(std::vector<std::size_t> bufferClasses = { 2048, 8192, 65536 },
+				bool hugePages = false, std::size_t threadCacheSize = 64);
+
+			virtual ~BufferPool() = default;
+
+			// non copyable
+			BufferPool(const BufferPool&) = delete;
+			BufferPool& operator=(const BufferPool&) = delete;
+
+			/**
+			 * @brief Acquires a buffer of the smallest class that fits the requested size.
+			 * Requests that are larger than the largest class are served by the heap.
+			 * @param minSize Minimum capacity of the buffer.
+			 * @return A buffer whose size is 0.
+			 * @exception This function throws std::bad_alloc if the memory cannot be allocated.
+			 */
+			NODISCARD PooledBuffer acquire(std::size_t minSize);
+
+			/**
+			 * @brief Gets the process wide pool that is used when no pool is given.
+			 * @return The default pool.
+			 * @exception This function throws std::bad_alloc if the pool cannot be created.
+			 */
+			static BufferPool& defaultPool();
+
+		private:
+			friend class PooledBuffer;
+
+			static void recycle(BufferPoolState& state, std::size_t classIndex, char* data) noexcept;
+
+			std::shared_ptr<BufferPoolState> m_state;
+		};
+	}
+}
+
+#endif // BUFFER_POOL_H
@@ -0,0 +1,141 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "CancellationToken.h"
+#include "SocketException.h"
+
+#include <cerrno>
+#include <cstdint>
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#elif !defined(_WIN32)
+#include <fcntl.h>
+#endif
+
+namespace sdk {
+	namespace network {
+
+		CancellationToken::CancellationToken()
+		{
+#ifdef __linux__
+			m_eventFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			if (m_eventFd < 0) {
+				throw general::SocketException(errno);
+			}
+#elif defined(_WIN32)
+			m_signalSocket = socket(AF_INET, SOCK_DGRAM, 0);
+			if (m_signalSocket == INVALID_SOCKET) {
+				throw general::SocketException(WSAGetLastError());
+			}
+
+			struct sockaddr_in address{};
+			address.sin_family = AF_INET;
+			address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			socklen_t addressSize = sizeof(address);
+			unsigned long nonBlocking = 1;
+
+			if (::bind(m_signalSocket, reinterpret_cast<const sockaddr*>(&address), addressSize) == SOCKET_ERROR ||
+				getsockname(m_signalSocket, reinterpret_cast<sockaddr*>(&address), &addressSize) == SOCKET_ERROR ||
+				::connect(m_signalSocket, reinterpret_cast<const sockaddr*>(&address), addressSize) == SOCKET_ERROR ||
+				ioctlsocket(m_signalSocket, FIONBIO, &nonBlocking) == SOCKET_ERROR) {
+				const auto err = WSAGetLastError();
+				closesocket(m_signalSocket);
+				throw general::SocketException(err);
+			}
+#else
+			if (pipe(m_pipeFds) != 0) {
+				throw general::SocketException(errno);
+			}
+			for (const int fd : m_pipeFds) {
+				(void)fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+				(void)fcntl(fd, F_SETFD, FD_CLOEXEC);
+			}
+#endif
+		}
+
+		CancellationToken::~CancellationToken()
+		{
+#ifdef __linux__
+			close(m_eventFd);
+#elif defined(_WIN32)
+			closesocket(m_signalSocket);
+#else
+			close(m_pipeFds[0]);
+			close(m_pipeFds[1]);
+#endif
+		}
+
+		void CancellationToken::cancel() noexcept
+		{
+			//	the handle is signalled once, it stays readable until reset
+			std::lock_guard<std::mutex> lock{ m_signalLock };
+			if (m_cancelled.exchange(true, std::memory_order_acq_rel)) {
+				return;
+			}
+
+#ifdef __linux__
+			const std::uint64_t value = 1;
+			(void)write(m_eventFd, &value, sizeof(value));
+#elif defined(_WIN32)
+			const char value = 1;
+			(void)send(m_signalSocket, &value, sizeof(value), 0);
+#else
+			const char value = 1;
+			(void)write(m_pipeFds[1], &value, sizeof(value));
+#endif
+		}
+
+		void CancellationToken::reset() noexcept
+		{
+			//	a cancel() in between must not be drained with the previous signal
+			std::lock_guard<std::mutex> lock{ m_signalLock };
+			if (!m_cancelled.exchange(false, std::memory_order_acq_rel)) {
+				return;
+			}
+
+#ifdef __linux__
+			std::uint64_t value = 0;
+			(void)read(m_eventFd, &value, sizeof(value));
+#elif defined(_WIN32)
+			char buffer[16];
+			while (recv(m_signalSocket, buffer, sizeof(buffer), 0) > 0) {
+			}
+#else
+			char buffer[16];
+			while (read(m_pipeFds[0], buffer, sizeof(buffer)) > 0) {
+			}
+#endif
+		}
+
+		SOCKET CancellationToken::getWaitHandle() const noexcept
+		{
+#ifdef __linux__
+			return static_cast<SOCKET>(m_eventFd);
+#elif defined(_WIN32)
+			return m_signalSocket;
+#else
+			return static_cast<SOCKET>(m_pipeFds[0]);
+#endif
+		}
+	}
+}
@@ -0,0 +1,97 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef CANCELLATION_TOKEN_H
+#define CANCELLATION_TOKEN_H
+
+#include "SocketDescriptor.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace sdk {
+	namespace network {
+
+		constexpr const char* const CANCEL_MSG = "The operation is cancelled.";
+
+		/**
+		 * @brief CancellationToken class aborts blocking socket operations from another thread.
+		 * @details The token owns a handle that becomes readable when it is cancelled (an eventfd on
+		 *	Linux, a pipe on other POSIX systems and a self connected udp socket on Windows). Waits
+		 *	watch it next to the socket, so a cancellation wakes them immediately and an idle socket
+		 *	does not need to poll a flag.
+		 */
+		class SOCKET_API CancellationToken {
+		public:
+			/**
+			 * @brief Creates a token that is not cancelled.
+			 * @exception this function throws an SocketException if the handle cannot be created.
+			 */
+			CancellationToken();
+			virtual ~CancellationToken();
+
+			// non copyable
+			CancellationToken(const CancellationToken&) = delete;
+			CancellationToken& operator=(const CancellationToken&) = delete;
+
+			/**
+			 * @brief Cancels the operations that wait on the token, the current and the following ones.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void cancel() noexcept;
+
+			/**
+			 * @brief Makes the token usable again after a cancellation. Call it when no operation waits
+			 * on the token, a waiting operation may return as cancelled or keep waiting.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void reset() noexcept;
+
+			NODISCARD bool isCancelled() const noexcept
+			{
+				return m_cancelled.load(std::memory_order_acquire);
+			}
+
+			/**
+			 * @brief Gets the handle that becomes readable when the token is cancelled.
+			 * @return The handle to poll.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD SOCKET getWaitHandle() const noexcept;
+
+		private:
+			std::atomic<bool> m_cancelled{ false };
+			std::mutex m_signalLock; // keeps the flag and the handle in step between cancel() and reset()
+#ifdef __linux__
+			int m_eventFd{ -1 };
+#elif defined(_WIN32)
+			SOCKET m_signalSocket{ INVALID_SOCKET }; // self connected udp socket
+#else
+			int m_pipeFds[2]{ -1, -1 };
+#endif
+		};
+	}
+}
+
+#endif // CANCELLATION_TOKEN_H
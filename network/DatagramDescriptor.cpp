@@ -0,0 +1,395 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "DatagramDescriptor.h"
+#include "Socket.h"
+#include "SocketException.h"
+#include "Reactor.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#if defined(__linux__)
+#include <netinet/udp.h>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+#endif
+
+namespace sdk {
+	namespace network {
+
+		namespace {
+			constexpr const int WAIT_SLICE = 100; // milliseconds, the interrupt callback is checked in between
+			constexpr const std::size_t MAX_GSO_SEGMENTS = 64; // kernel limit of segments per send
+			constexpr const std::size_t MAX_GSO_PAYLOAD = 65507; // largest udp payload over IPv4
+
+			//	the part of a timeout that is left until its deadline, rounded up; a negative timeout stays infinite
+			std::chrono::milliseconds getRemainingTimeout(std::chrono::steady_clock::time_point deadline,
+				std::chrono::milliseconds timeout) noexcept
+			{
+				if (timeout.count() < 0) {
+					return timeout;
+				}
+
+				const auto remaining = deadline - std::chrono::steady_clock::now();
+				if (remaining <= std::chrono::steady_clock::duration::zero()) {
+					return std::chrono::milliseconds{ 0 };
+				}
+				return std::chrono::duration_cast<std::chrono::milliseconds>(remaining +
+					std::chrono::milliseconds{ 1 } - std::chrono::steady_clock::duration{ 1 });
+			}
+		}
+
+		// std::min/std::max bind them to references, before C++17 they need a definition
+		constexpr std::size_t DatagramDescriptor::MAX_BATCH_SIZE;
+		constexpr std::size_t DatagramDescriptor::MAX_GRO_SIZE;
+
+		DatagramDescriptor::DatagramDescriptor(const Socket& socketRef, BufferPool& pool /*= BufferPool::defaultPool()*/,
+			std::size_t maxDatagramSize /*= DEFAULT_MAX_DATAGRAM_SIZE*/) noexcept :
+			m_socketId{ socketRef.getSocketId() },
+			m_socketRef{ socketRef },
+			m_pool{ pool },
+			m_maxDatagramSize{ maxDatagramSize }
+		{
+		}
+
+		std::size_t DatagramDescriptor::receiveBatch(std::vector<Datagram>& datagrams, std::size_t maxCount /*= MAX_BATCH_SIZE*/,
+			std::chrono::milliseconds timeout /*= std::chrono::milliseconds{ -1 }*/)
+		{
+			maxCount = (std::min)(maxCount, MAX_BATCH_SIZE);
+			if (maxCount == 0) {
+				return 0;
+			}
+
+			//	a spurious wake up waits only for the rest of the timeout
+			const auto deadline = std::chrono::steady_clock::now() + timeout;
+			const auto firstIndex = datagrams.size();
+			std::size_t receiveCount = 0;
+			while (receiveCount == 0) {
+				if (!waitForEvent(EVENT_READ, getRemainingTimeout(deadline, timeout))) {
+					return 0;
+				}
+
+				datagrams.resize(firstIndex + maxCount);
+				for (auto index = firstIndex; index < datagrams.size(); ++index) {
+					if (datagrams[index].payload.capacity() < m_maxDatagramSize) {
+						datagrams[index].payload = m_pool.acquire(m_maxDatagramSize);
+					}
+				}
+
+#if defined(__linux__)
+				//	the whole batch is received by a single system call
+				mmsghdr messages[MAX_BATCH_SIZE]{};
+				iovec vectors[MAX_BATCH_SIZE]{};
+				alignas(cmsghdr) char controls[MAX_BATCH_SIZE][CMSG_SPACE(sizeof(int))];
+				for (std::size_t index = 0; index < maxCount; ++index) {
+					auto& datagram = datagrams[firstIndex + index];
+					vectors[index].iov_base = datagram.payload.data();
+					vectors[index].iov_len = m_maxDatagramSize;
+					messages[index].msg_hdr.msg_iov = &vectors[index];
+					messages[index].msg_hdr.msg_iovlen = 1;
+					messages[index].msg_hdr.msg_name = datagram.peer.data();
+					messages[index].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+					if (m_groEnabled) {
+						messages[index].msg_hdr.msg_control = controls[index];
+						messages[index].msg_hdr.msg_controllen = sizeof(controls[index]);
+					}
+				}
+
+				const int received = recvmmsg(m_socketId, messages, static_cast<unsigned int>(maxCount), MSG_DONTWAIT, nullptr);
+				if (received == SOCKET_ERROR) {
+					const int lastError = WSAGetLastError();
+					if (lastError != WSAEWOULDBLOCK) {
+						datagrams.resize(firstIndex);
+						throw general::SocketException(lastError);
+					}
+				}
+
+				for (int index = 0; index < received; ++index) {
+					auto& datagram = datagrams[firstIndex + index];
+					datagram.payload.setSize(messages[index].msg_len);
+					datagram.peer.setSize(messages[index].msg_hdr.msg_namelen);
+					datagram.segmentSize = 0;
+					datagram.truncated = (messages[index].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+
+					//	a coalesced payload carries the size of its segments
+					auto& header = messages[index].msg_hdr;
+					for (auto* control = CMSG_FIRSTHDR(&header); control != nullptr; control = CMSG_NXTHDR(&header, control)) {
+						if (control->cmsg_level == IPPROTO_UDP && control->cmsg_type == UDP_GRO) {
+							int segmentSize = 0;
+							std::memcpy(&segmentSize, CMSG_DATA(control), sizeof(segmentSize));
+							datagram.segmentSize = static_cast<std::size_t>(segmentSize);
+						}
+					}
+					++receiveCount;
+				}
+#else
+				//	receive one by one while more datagrams are ready
+				for (std::size_t index = 0; index < maxCount; ++index) {
+					if (index > 0 && (Reactor::waitFor(m_socketId, EVENT_READ, 0) & EVENT_READ) == 0) {
+						break;
+					}
+
+					auto& datagram = datagrams[firstIndex + index];
+					socklen_t peerSize = sizeof(sockaddr_storage);
+					bool truncated = false;
+#ifdef _WIN32
+					auto received = recvfrom(m_socketId, datagram.payload.data(), static_cast<int>(m_maxDatagramSize), 0,
+						datagram.peer.data(), &peerSize);
+
+					//	the beginning of a larger datagram is received and reported as an error
+					if (received == SOCKET_ERROR && WSAGetLastError() == WSAEMSGSIZE) {
+						received = static_cast<int>(m_maxDatagramSize);
+						truncated = true;
+					}
+#else
+					//	recvfrom cuts a larger datagram silently, recvmsg reports it
+					iovec vector{ datagram.payload.data(), m_maxDatagramSize };
+					msghdr header{};
+					header.msg_name = datagram.peer.data();
+					header.msg_namelen = peerSize;
+					header.msg_iov = &vector;
+					header.msg_iovlen = 1;
+					const auto received = recvmsg(m_socketId, &header, 0);
+					peerSize = header.msg_namelen;
+					truncated = (header.msg_flags & MSG_TRUNC) != 0;
+#endif
+					if (received == SOCKET_ERROR) {
+						const int lastError = WSAGetLastError();
+						if (lastError == WSAEWOULDBLOCK) {
+							break;
+						}
+						datagrams.resize(firstIndex);
+						throw general::SocketException(lastError);
+					}
+
+					datagram.payload.setSize(static_cast<std::size_t>(received));
+					datagram.peer.setSize(peerSize);
+					datagram.segmentSize = 0;
+					datagram.truncated = truncated;
+					++receiveCount;
+				}
+#endif
+				datagrams.resize(firstIndex + receiveCount);
+			}
+
+			return receiveCount;
+		}
+
+		void DatagramDescriptor::sendBatch(const Datagram* datagrams, std::size_t count)
+		{
+			std::size_t sentCount = 0;
+			while (sentCount < count) {
+#if defined(__linux__)
+				const auto batchSize = (std::min)(count - sentCount, MAX_BATCH_SIZE);
+				mmsghdr messages[MAX_BATCH_SIZE]{};
+				iovec vectors[MAX_BATCH_SIZE]{};
+				for (std::size_t index = 0; index < batchSize; ++index) {
+					const auto& datagram = datagrams[sentCount + index];
+					vectors[index].iov_base = const_cast<char*>(datagram.payload.data());
+					vectors[index].iov_len = datagram.payload.size();
+					messages[index].msg_hdr.msg_iov = &vectors[index];
+					messages[index].msg_hdr.msg_iovlen = 1;
+					messages[index].msg_hdr.msg_name = const_cast<sockaddr*>(datagram.peer.data());
+					messages[index].msg_hdr.msg_namelen = datagram.peer.size();
+				}
+
+				const int sent = sendmmsg(m_socketId, messages, static_cast<unsigned int>(batchSize), MSG_DONTWAIT);
+				if (sent != SOCKET_ERROR) {
+					sentCount += static_cast<std::size_t>(sent);
+					continue;
+				}
+#else
+				const auto& datagram = datagrams[sentCount];
+				if (sendto(m_socketId, datagram.payload.data(), static_cast<int>(datagram.payload.size()), 0,
+					datagram.peer.data(), datagram.peer.size()) != SOCKET_ERROR) {
+					++sentCount;
+					continue;
+				}
+#endif
+				const int lastError = WSAGetLastError();
+				if (lastError != WSAEWOULDBLOCK) {
+					throw general::SocketException(lastError);
+				}
+				(void)waitForEvent(EVENT_WRITE, std::chrono::milliseconds{ -1 });
+			}
+		}
+
+		void DatagramDescriptor::sendTo(const char* data, std::size_t dataSize, const PeerAddress& peer)
+		{
+			const int sendSize = static_cast<int>((std::min)(dataSize, static_cast<std::size_t>(INT_MAX)));
+			while (sendto(m_socketId, data, sendSize, 0, peer.data(), peer.size()) == SOCKET_ERROR) {
+				const int lastError = WSAGetLastError();
+				if (lastError != WSAEWOULDBLOCK) {
+					throw general::SocketException(lastError);
+				}
+				(void)waitForEvent(EVENT_WRITE, std::chrono::milliseconds{ -1 });
+			}
+		}
+
+		void DatagramDescriptor::sendSegmented(const char* data, std::size_t dataSize, std::size_t segmentSize, const PeerAddress& peer)
+		{
+			if (segmentSize == 0) {
+				throw general::SocketException("The segment size is zero.");
+			}
+
+			if (sendGso(data, dataSize, segmentSize, peer)) {
+				return;
+			}
+
+			for (std::size_t offset = 0; offset < dataSize; offset += segmentSize) {
+				sendTo(data + offset, (std::min)(segmentSize, dataSize - offset), peer);
+			}
+		}
+
+		bool DatagramDescriptor::sendGso(const char* data, std::size_t dataSize, std::size_t segmentSize, const PeerAddress& peer)
+		{
+#if defined(__linux__)
+			if (m_gsoState == OffloadState::unknown) {
+				int value = 0;
+				socklen_t valueSize = sizeof(value);
+				m_gsoState = getsockopt(m_socketId, IPPROTO_UDP, UDP_SEGMENT, &value, &valueSize) == 0 ? OffloadState::enabled : OffloadState::disabled;
+			}
+
+			const auto segmentsPerSend = (std::min)(MAX_GSO_SEGMENTS, MAX_GSO_PAYLOAD / segmentSize);
+			if (m_gsoState != OffloadState::enabled || segmentsPerSend < 2) {
+				return false;
+			}
+
+			//	each send hands the kernel as many segments as it accepts at once
+			std::size_t offset = 0;
+			while (offset < dataSize) {
+				const auto sendSize = (std::min)(segmentsPerSend * segmentSize, dataSize - offset);
+
+				iovec vector{ const_cast<char*>(data + offset), sendSize };
+				alignas(cmsghdr) char control[CMSG_SPACE(sizeof(std::uint16_t))]{};
+				msghdr header{};
+				header.msg_name = const_cast<sockaddr*>(peer.data());
+				header.msg_namelen = peer.size();
+				header.msg_iov = &vector;
+				header.msg_iovlen = 1;
+
+				if (sendSize > segmentSize) {
+					header.msg_control = control;
+					header.msg_controllen = sizeof(control);
+					auto* segmentControl = CMSG_FIRSTHDR(&header);
+					segmentControl->cmsg_level = IPPROTO_UDP;
+					segmentControl->cmsg_type = UDP_SEGMENT;
+					segmentControl->cmsg_len = CMSG_LEN(sizeof(std::uint16_t));
+					const auto segment = static_cast<std::uint16_t>(segmentSize);
+					std::memcpy(CMSG_DATA(segmentControl), &segment, sizeof(segment));
+				}
+
+				if (sendmsg(m_socketId, &header, MSG_DONTWAIT) != SOCKET_ERROR) {
+					offset += sendSize;
+					continue;
+				}
+
+				const int lastError = WSAGetLastError();
+				if (lastError == WSAEWOULDBLOCK) {
+					(void)waitForEvent(EVENT_WRITE, std::chrono::milliseconds{ -1 });
+					continue;
+				}
+
+				//	the device cannot segment, the rest is sent datagram by datagram
+				if (offset == 0 && (lastError == EIO || lastError == ENOPROTOOPT || lastError == EOPNOTSUPP)) {
+					m_gsoState = OffloadState::disabled;
+					return false;
+				}
+				throw general::SocketException(lastError);
+			}
+			return true;
+#else
+			(void)data;
+			(void)dataSize;
+			(void)segmentSize;
+			(void)peer;
+			return false;
+#endif
+		}
+
+		bool DatagramDescriptor::enableGro() noexcept
+		{
+#if defined(__linux__)
+			const int enable = 1;
+			if (setsockopt(m_socketId, IPPROTO_UDP, UDP_GRO, &enable, sizeof(enable)) == SOCKET_ERROR) {
+				return false;
+			}
+
+			m_groEnabled = true;
+			m_maxDatagramSize = (std::max)(m_maxDatagramSize, MAX_GRO_SIZE);
+			return true;
+#else
+			return false;
+#endif
+		}
+
+		std::size_t DatagramDescriptor::splitSegments(const Datagram& datagram, std::vector<ConstBuffer>& segments)
+		{
+			const auto* data = datagram.payload.data();
+			const auto dataSize = datagram.payload.size();
+			const auto segmentSize = datagram.segmentSize > 0 ? datagram.segmentSize : dataSize;
+			if (segmentSize == 0) {
+				segments.push_back(ConstBuffer{ data, 0 });
+				return 1;
+			}
+
+			std::size_t count = 0;
+			for (std::size_t offset = 0; offset < dataSize; offset += segmentSize, ++count) {
+				segments.push_back(ConstBuffer{ data + offset, (std::min)(segmentSize, dataSize - offset) });
+			}
+			return count;
+		}
+
+		bool DatagramDescriptor::waitForEvent(std::uint32_t event, std::chrono::milliseconds timeout) const
+		{
+			const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
+			const auto deadline = std::chrono::steady_clock::now() + timeout;
+
+			while (true) {
+				if (callbackInterrupt && callbackInterrupt(m_socketRef)) {
+					throw general::SocketException(INTERRUPT_MSG);
+				}
+
+				int waitMs = WAIT_SLICE;
+				if (timeout.count() >= 0) {
+					const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+					waitMs = static_cast<int>((std::min)(remaining, std::chrono::milliseconds{ WAIT_SLICE }).count());
+				}
+
+				//	an error is reported by the following receive or send call
+				if ((Reactor::waitFor(m_socketId, event, (std::max)(waitMs, 0), m_socketRef.getCancellationToken()) & (event | EVENT_ERROR)) != 0) {
+					return true;
+				}
+				if (waitMs <= 0) {
+					return false;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,154 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef DATAGRAM_DESCRIPTOR_H
+#define DATAGRAM_DESCRIPTOR_H
+
+#include "SocketDescriptor.h"
+#include "BufferPool.h"
+#include "PeerAddress.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace sdk {
+	namespace network {
+
+		class Socket; // forward declaration
+
+		// a datagram and the address it is received from or sent to
+		struct Datagram {
+			PooledBuffer payload;
+			PeerAddress peer;
+			std::size_t segmentSize{}; // size of coalesced segments (UDP GRO), 0 if the payload is one datagram
+			bool truncated{};		   // the datagram did not fit, the payload holds its beginning
+		};
+
+		/**
+		 * @brief DatagramDescriptor class receives and sends datagrams in batches.
+		 * @details Linux moves a whole batch with a single recvmmsg/sendmmsg call, other platforms
+		 *	loop over the ready datagrams. Received payloads are drawn from a buffer pool. The socket
+		 *	is borrowed from the udp Socket and stays owned by it.
+		 */
+		class SOCKET_API DatagramDescriptor {
+		public:
+			explicit DatagramDescriptor(const Socket& socketRef, BufferPool& pool = BufferPool::defaultPool(),
+				std::size_t maxDatagramSize = DEFAULT_MAX_DATAGRAM_SIZE) noexcept;
+			virtual ~DatagramDescriptor() = default;
+
+			// non copyable
+			DatagramDescriptor(const DatagramDescriptor&) = delete;
+			DatagramDescriptor& operator=(const DatagramDescriptor&) = delete;
+
+			/**
+			 * @brief Receives the datagrams that are ready, up to maxCount. It waits for the first one.
+			 * A datagram larger than the maximum datagram size is cut and flagged as truncated.
+			 * @param datagrams The received datagrams are appended to it.
+			 * @param maxCount Maximum count of datagrams, it is clamped to MAX_BATCH_SIZE.
+			 * @param timeout Maximum time to wait for the first datagram, a negative value waits forever.
+			 * @return The count of received datagrams, 0 if the timeout expired.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD virtual std::size_t receiveBatch(std::vector<Datagram>& datagrams, std::size_t maxCount = MAX_BATCH_SIZE,
+				std::chrono::milliseconds timeout = std::chrono::milliseconds{ -1 });
+
+			/**
+			 * @brief Sends every datagram to its peer. It waits while the send buffer of the socket is full.
+			 * @param datagrams The datagrams to send, payload sizes are the valid bytes of the buffers.
+			 * @param count The count of datagrams.
+			 * @return nothing.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			virtual void sendBatch(const Datagram* datagrams, std::size_t count);
+
+			/**
+			 * @brief Sends a single datagram.
+			 * @param data Bytes of datagram.
+			 * @param dataSize Size of datagram.
+			 * @param peer The destination.
+			 * @return nothing.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			virtual void sendTo(const char* data, std::size_t dataSize, const PeerAddress& peer);
+
+			/**
+			 * @brief Sends a large buffer as consecutive datagrams of segmentSize bytes, the last one may
+			 * be shorter. Linux segments the buffer in the kernel or the NIC (UDP_SEGMENT), so a single
+			 * system call sends up to 64 datagrams. Other platforms send the segments one by one.
+			 * @param data Bytes of all segments.
+			 * @param dataSize Size of all segments.
+			 * @param segmentSize Size of each datagram.
+			 * @param peer The destination.
+			 * @return nothing.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			virtual void sendSegmented(const char* data, std::size_t dataSize, std::size_t segmentSize, const PeerAddress& peer);
+
+			/**
+			 * @brief Lets the kernel coalesce consecutive datagrams of a peer into one payload (UDP_GRO).
+			 * The coalesced datagrams report their segment size, splitSegments() separates them again.
+			 * The receive buffers grow to MAX_GRO_SIZE.
+			 * @return true if coalescing is enabled, false if the platform does not support it.
+			 * @exception This function never throws an exception.
+			 */
+			bool enableGro() noexcept;
+
+			/**
+			 * @brief Splits a received payload into its datagrams without copying.
+			 * @param datagram A received datagram, it is returned as is if it is not coalesced.
+			 * @param segments Views of the datagrams are appended to it.
+			 * @return The count of appended datagrams.
+			 * @exception This function never throws an exception.
+			 */
+			static std::size_t splitSegments(const Datagram& datagram, std::vector<ConstBuffer>& segments);
+
+			NODISCARD SOCKET getSocketId() const noexcept
+			{
+				return m_socketId;
+			}
+
+			static constexpr std::size_t DEFAULT_MAX_DATAGRAM_SIZE = 2048;
+			static constexpr std::size_t MAX_BATCH_SIZE = 64;
+			static constexpr std::size_t MAX_GRO_SIZE = 65535;
+
+		private:
+			enum class OffloadState : std::uint8_t {
+				unknown = 0,
+				enabled,
+				disabled
+			};
+
+			bool waitForEvent(std::uint32_t event, std::chrono::milliseconds timeout) const;
+			bool sendGso(const char* data, std::size_t dataSize, std::size_t segmentSize, const PeerAddress& peer);
+
+			SOCKET m_socketId{ INVALID_SOCKET };
+			const Socket& m_socketRef;
+			BufferPool& m_pool;
+			std::size_t m_maxDatagramSize;
+			bool m_groEnabled{};
+			OffloadState m_gsoState{ OffloadState::unknown };
+		};
+	}
+}
+
+#endif // DATAGRAM_DESCRIPTOR_H
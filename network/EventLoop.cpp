@@ -0,0 +1,155 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "EventLoop.h"
+#include "SocketException.h"
+
+#if SOCKET_COROUTINES_SUPPORTED
+
+namespace sdk {
+	namespace network {
+
+		EventLoop::~EventLoop()
+		{
+			// a task frame owns the frames it awaits, so destroying it releases the whole chain.
+			while (!m_frames.empty()) {
+				// the promise removes the frame from the set
+				std::coroutine_handle<>::from_address(*m_frames.begin()).destroy();
+			}
+		}
+
+		void EventLoop::spawn(Task<void> task) noexcept
+		{
+			(void)runDetached(std::move(task));
+		}
+
+		EventLoop::DetachedTask EventLoop::runDetached(Task<void> task)
+		{
+			++m_activeTasks;
+			try {
+				co_await task;
+			}
+			catch (...) {
+				if (!m_taskError) {
+					m_taskError = std::current_exception();
+				}
+			}
+			--m_activeTasks;
+		}
+
+		void EventLoop::run()
+		{
+			while (!m_stopped && m_activeTasks > 0) {
+				(void)m_reactor.runOnce(-1);
+
+				if (m_taskError) {
+					std::exception_ptr taskError;
+					std::swap(taskError, m_taskError);
+					std::rethrow_exception(taskError);
+				}
+			}
+			m_stopped = false;
+		}
+
+		void EventLoop::stop() noexcept
+		{
+			m_stopped = true;
+			m_reactor.wakeup();
+		}
+
+		EventLoop::ReadyAwaiter EventLoop::waitFor(SOCKET socketId, std::uint32_t events) noexcept
+		{
+			return ReadyAwaiter{ *this, socketId, events };
+		}
+
+		void EventLoop::ReadyAwaiter::await_suspend(std::coroutine_handle<> handle)
+		{
+			m_handle = handle;
+			m_loop.addWaiter(*this);
+		}
+
+		void EventLoop::addWaiter(ReadyAwaiter& awaiter)
+		{
+			const auto iter = m_waiters.find(awaiter.m_socketId);
+			Waiters waiters = iter != m_waiters.end() ? iter->second : Waiters{};
+
+			auto& slot = (awaiter.m_events & EVENT_WRITE) != 0 ? waiters.writer : waiters.reader;
+			if (slot != nullptr) {
+				throw general::SocketException("The socket is already awaited in this direction");
+			}
+			slot = &awaiter;
+
+			const std::uint32_t events = (waiters.reader != nullptr ? EVENT_READ : EVENT_NONE) |
+										 (waiters.writer != nullptr ? EVENT_WRITE : EVENT_NONE);
+			if (iter == m_waiters.end()) {
+				m_reactor.add(awaiter.m_socketId, events, [this](SOCKET socketId, std::uint32_t readyEvents) {
+					onReady(socketId, readyEvents);
+				});
+				m_waiters.emplace(awaiter.m_socketId, waiters);
+			}
+			else {
+				m_reactor.modify(awaiter.m_socketId, events);
+				iter->second = waiters;
+			}
+		}
+
+		void EventLoop::onReady(SOCKET socketId, std::uint32_t events)
+		{
+			const auto iter = m_waiters.find(socketId);
+			if (iter == m_waiters.end()) {
+				return;
+			}
+
+			// an error wakes up both directions, the operation itself reports the error.
+			const bool wakeAll = (events & EVENT_ERROR) != 0;
+			auto& waiters = iter->second;
+			ReadyAwaiter* reader = nullptr;
+			ReadyAwaiter* writer = nullptr;
+			if (waiters.reader != nullptr && (wakeAll || (events & EVENT_READ) != 0)) {
+				std::swap(reader, waiters.reader);
+			}
+			if (waiters.writer != nullptr && (wakeAll || (events & EVENT_WRITE) != 0)) {
+				std::swap(writer, waiters.writer);
+			}
+
+			// registrations are one-shot, so a closed socket never stays in the reactor.
+			if (waiters.reader == nullptr && waiters.writer == nullptr) {
+				m_waiters.erase(iter);
+				m_reactor.remove(socketId);
+			}
+			else {
+				m_reactor.modify(socketId, waiters.reader != nullptr ? EVENT_READ : EVENT_WRITE);
+			}
+
+			if (reader != nullptr) {
+				reader->m_readyEvents = events;
+				reader->m_handle.resume();
+			}
+			if (writer != nullptr) {
+				writer->m_readyEvents = events;
+				writer->m_handle.resume();
+			}
+		}
+	}
+}
+
+#endif // SOCKET_COROUTINES_SUPPORTED
@@ -0,0 +1,195 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef EVENT_LOOP_H
+#define EVENT_LOOP_H
+
+#include "Reactor.h"
+#include "Task.h"
+
+#if SOCKET_COROUTINES_SUPPORTED
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace sdk {
+	namespace network {
+
+		/**
+		 * @brief EventLoop class runs coroutine tasks on top of a Reactor.
+		 * @details A coroutine that waits for a socket is suspended until the reactor reports
+		 *	the requested readiness, then it is resumed on the thread that calls run().
+		 *	Each socket may have one reader and one writer waiting at the same time.
+		 */
+		class SOCKET_API EventLoop {
+		public:
+			class ReadyAwaiter;
+
+			EventLoop() = default;
+
+			/**
+			 * @brief Destroys the frames of the spawned tasks that are still suspended, together with
+			 * the tasks they await. They are not resumed, so their code after the suspension point never runs.
+			 */
+			virtual ~EventLoop();
+
+			// non copyable
+			EventLoop(const EventLoop&) = delete;
+			EventLoop& operator=(const EventLoop&) = delete;
+
+			/**
+			 * @brief Starts a task on the loop. The task runs until its first suspension point.
+			 * @param task The task to run, its frame is owned by the loop until it completes.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void spawn(Task<void> task) noexcept;
+
+			/**
+			 * @brief Resumes waiting tasks until all spawned tasks complete or stop() is called.
+			 * @return nothing.
+			 * @exception this function rethrows the first exception that escapes a spawned task
+			 *	and throws an SocketException if the reactor fails.
+			 */
+			void run();
+
+			/**
+			 * @brief Stops the run() loop. It is safe to call from any thread.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void stop() noexcept;
+
+			/**
+			 * @brief Suspends the awaiting coroutine until the socket is ready.
+			 * @param socketId The id of socket.
+			 * @param events EVENT_READ or EVENT_WRITE.
+			 * @return An awaitable object, co_await yields the ready events.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD ReadyAwaiter waitFor(SOCKET socketId, std::uint32_t events) noexcept;
+
+			/**
+			 * @brief Gets the reactor of the loop, it can be used for callback based registrations.
+			 * @return The reactor.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD Reactor& getReactor() noexcept
+			{
+				return m_reactor;
+			}
+
+			class SOCKET_API ReadyAwaiter {
+			public:
+				ReadyAwaiter(EventLoop& loop, SOCKET socketId, std::uint32_t events) noexcept :
+					m_loop{ loop },
+					m_socketId{ socketId },
+					m_events{ events }
+				{
+				}
+
+				bool await_ready() const noexcept
+				{
+					return false;
+				}
+
+				void await_suspend(std::coroutine_handle<> handle);
+
+				std::uint32_t await_resume() const noexcept
+				{
+					return m_readyEvents;
+				}
+
+			private:
+				friend class EventLoop;
+
+				EventLoop& m_loop;
+				SOCKET m_socketId;
+				std::uint32_t m_events;
+				std::uint32_t m_readyEvents{ EVENT_NONE };
+				std::coroutine_handle<> m_handle;
+			};
+
+		private:
+			struct Waiters {
+				ReadyAwaiter* reader{};
+				ReadyAwaiter* writer{};
+			};
+
+			struct DetachedTask {
+				struct promise_type {
+					// the frame is registered to the loop, so that the loop can destroy it while it is suspended
+					promise_type(EventLoop& loop, Task<void>&) :
+						m_loop{ loop }
+					{
+						m_loop.m_frames.insert(std::coroutine_handle<promise_type>::from_promise(*this).address());
+					}
+
+					~promise_type()
+					{
+						m_loop.m_frames.erase(std::coroutine_handle<promise_type>::from_promise(*this).address());
+					}
+
+					DetachedTask get_return_object() const noexcept
+					{
+						return {};
+					}
+
+					std::suspend_never initial_suspend() const noexcept
+					{
+						return {};
+					}
+
+					std::suspend_never final_suspend() const noexcept
+					{
+						return {};
+					}
+
+					void return_void() const noexcept {}
+
+					void unhandled_exception() const noexcept {}
+
+					EventLoop& m_loop;
+				};
+			};
+
+			DetachedTask runDetached(Task<void> task);
+			void addWaiter(ReadyAwaiter& awaiter);
+			void onReady(SOCKET socketId, std::uint32_t events);
+
+			Reactor m_reactor;
+			std::unordered_map<SOCKET, Waiters> m_waiters;
+			std::unordered_set<void*> m_frames; // frame addresses of the spawned tasks
+			std::size_t m_activeTasks{};
+			std::exception_ptr m_taskError;
+			std::atomic<bool> m_stopped{ false };
+		};
+	}
+}
+
+#endif // SOCKET_COROUTINES_SUPPORTED
+
+#endif // EVENT_LOOP_H
@@ -0,0 +1,140 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "FrameCodec.h"
+#include "SocketException.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace sdk {
+	namespace network {
+
+		namespace {
+			constexpr const std::size_t MIN_READ_SIZE = 4096; // free space that is requested from each read
+		}
+
+		FrameCodec::FrameCodec(SocketDescriptor& descriptor, FramePrefix prefix /*= FramePrefix::fourBytes*/,
+			ByteOrder byteOrder /*= ByteOrder::bigEndian*/, std::size_t maxFrameSize /*= DEFAULT_MAX_FRAME_SIZE*/) :
+			m_descriptor{ descriptor },
+			m_prefix{ prefix },
+			m_byteOrder{ byteOrder },
+			m_maxFrameSize{ maxFrameSize }
+		{
+		}
+
+		bool FrameCodec::readFrame(std::string& message)
+		{
+			const auto prefixSize = static_cast<std::size_t>(m_prefix);
+
+			while (true) {
+				//	deliver a frame that is already buffered
+				std::size_t frameSize = 0;
+				if (getBufferedSize() >= prefixSize) {
+					const auto length = decodeLength(m_buffer.data() + m_begin, m_prefix, m_byteOrder);
+					if (length > m_maxFrameSize) {
+						throw general::SocketException("The frame is larger than the maximum frame size.");
+					}
+
+					frameSize = prefixSize + static_cast<std::size_t>(length);
+					if (getBufferedSize() >= frameSize) {
+						message.assign(m_buffer.data() + m_begin + prefixSize, static_cast<std::size_t>(length));
+						m_begin += frameSize;
+						if (m_begin == m_end) {
+							m_begin = m_end = 0;
+						}
+						return true;
+					}
+				}
+
+				//	make room for the rest of the frame, the consumed bytes are dropped first
+				if (m_begin > 0) {
+					std::memmove(m_buffer.data(), m_buffer.data() + m_begin, getBufferedSize());
+					m_end -= m_begin;
+					m_begin = 0;
+				}
+
+				const auto required = (std::max)(frameSize, m_end + MIN_READ_SIZE);
+				if (m_buffer.size() < required) {
+					m_buffer.resize(required);
+				}
+
+				//	a single receive per call, it waits up to the receive timeout for data
+				const MutableBuffer buffer{ m_buffer.data() + m_end, m_buffer.size() - m_end };
+				const auto receiveByte = m_descriptor.scatterRead(&buffer, 1);
+				if (receiveByte == 0) {
+					return false;
+				}
+				m_end += receiveByte;
+			}
+		}
+
+		void FrameCodec::writeFrame(const char* data, std::size_t dataSize)
+		{
+			const auto prefixSize = static_cast<std::size_t>(m_prefix);
+			if (prefixSize < sizeof(std::uint64_t) &&
+				static_cast<std::uint64_t>(dataSize) >= (std::uint64_t{ 1 } << (prefixSize * 8))) {
+				throw general::SocketException("The message does not fit in the frame prefix.");
+			}
+
+			char header[sizeof(std::uint64_t)];
+			encodeLength(dataSize, m_prefix, m_byteOrder, header);
+
+			//	prefix and payload leave in a single system call (or TLS record) in the common case
+			const ConstBuffer buffers[]{ { header, prefixSize }, { data, dataSize } };
+			auto sendBytes = m_descriptor.gatherWrite(buffers, 2);
+
+			if (sendBytes < prefixSize) {
+				sendBytes += m_descriptor.writeAll(header + sendBytes, prefixSize - sendBytes);
+			}
+			const auto payloadSent = sendBytes - prefixSize;
+			if (payloadSent < dataSize) {
+				(void)m_descriptor.writeAll(data + payloadSent, dataSize - payloadSent);
+			}
+		}
+
+		void FrameCodec::encodeLength(std::uint64_t length, FramePrefix prefix, ByteOrder byteOrder, char* out) noexcept
+		{
+			const auto prefixSize = static_cast<std::size_t>(prefix);
+			for (std::size_t i = 0; i < prefixSize; ++i) {
+				const auto byte = static_cast<char>((length >> (8 * i)) & 0xff);
+				if (byteOrder == ByteOrder::bigEndian) {
+					out[prefixSize - 1 - i] = byte;
+				}
+				else {
+					out[i] = byte;
+				}
+			}
+		}
+
+		std::uint64_t FrameCodec::decodeLength(const char* in, FramePrefix prefix, ByteOrder byteOrder) noexcept
+		{
+			const auto prefixSize = static_cast<std::size_t>(prefix);
+			std::uint64_t length = 0;
+			for (std::size_t i = 0; i < prefixSize; ++i) {
+				const auto byte = static_cast<unsigned char>(byteOrder == ByteOrder::bigEndian ? in[i] : in[prefixSize - 1 - i]);
+				length = (length << 8) | byte;
+			}
+			return length;
+		}
+	}
+}
@@ -0,0 +1,138 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef FRAME_CODEC_H
+#define FRAME_CODEC_H
+
+#include "SocketDescriptor.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace sdk {
+	namespace network {
+
+		enum class FramePrefix : std::uint8_t {
+			twoBytes = 2,
+			fourBytes = 4,
+			eightBytes = 8
+		};
+
+		enum class ByteOrder : std::uint8_t {
+			bigEndian = 1, // network byte order
+			littleEndian
+		};
+
+		/**
+		 * @brief FrameCodec class sends and receives length prefixed messages over a descriptor.
+		 * @details Every message is preceded by its length in a 2, 4 or 8 byte prefix. A read returns
+		 *	exactly one complete message, the bytes that belong to partial or following frames are
+		 *	kept for the next read. It works with both plain and TLS descriptors.
+		 */
+		class SOCKET_API FrameCodec {
+		public:
+			explicit FrameCodec(SocketDescriptor& descriptor, FramePrefix prefix = FramePrefix::fourBytes,
+				ByteOrder byteOrder = ByteOrder::bigEndian, std::size_t maxFrameSize = DEFAULT_MAX_FRAME_SIZE);
+			virtual ~FrameCodec() = default;
+
+			// non copyable
+			FrameCodec(const FrameCodec&) = delete;
+			FrameCodec& operator=(const FrameCodec&) = delete;
+
+			/**
+			 * @brief Reads one complete message.
+			 * @param message The payload of the message without its prefix.
+			 * @return true if a message is read, false if the receive timeout expired or the connection
+			 *	is closed before a complete frame is received.
+			 * @exception this function throws an SocketException if an error occurs or the frame is
+			 *	larger than the maximum frame size.
+			 */
+			NODISCARD bool readFrame(std::string& message);
+
+			/**
+			 * @brief Writes one message with its length prefix.
+			 * @param data Bytes of message.
+			 * @param dataSize Size of message.
+			 * @return nothing.
+			 * @exception this function throws an SocketException if an error occurs or the message
+			 *	does not fit in the prefix.
+			 */
+			void writeFrame(const char* data, std::size_t dataSize);
+
+			/**
+			 * @brief Writes one message with its length prefix.
+			 * @param message The message.
+			 * @return nothing.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			void writeFrame(const std::string& message)
+			{
+				writeFrame(message.data(), message.size());
+			}
+
+			/**
+			 * @brief Gets the count of received bytes that are not returned as a message yet.
+			 * @return The count of buffered bytes.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD std::size_t getBufferedSize() const noexcept
+			{
+				return m_end - m_begin;
+			}
+
+			/**
+			 * @brief Encodes a length into a prefix.
+			 * @param length The length.
+			 * @param prefix Size of prefix.
+			 * @param byteOrder Byte order of prefix.
+			 * @param out Destination, at least the size of prefix.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			static void encodeLength(std::uint64_t length, FramePrefix prefix, ByteOrder byteOrder, char* out) noexcept;
+
+			/**
+			 * @brief Decodes a length from a prefix.
+			 * @param in Source, at least the size of prefix.
+			 * @param prefix Size of prefix.
+			 * @param byteOrder Byte order of prefix.
+			 * @return The length.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD static std::uint64_t decodeLength(const char* in, FramePrefix prefix, ByteOrder byteOrder) noexcept;
+
+			static constexpr std::size_t DEFAULT_MAX_FRAME_SIZE = 16 * 1024 * 1024;
+
+		private:
+			SocketDescriptor& m_descriptor;
+			FramePrefix m_prefix;
+			ByteOrder m_byteOrder;
+			std::size_t m_maxFrameSize;
+			std::vector<char> m_buffer;
+			std::size_t m_begin{}; // first byte that is not consumed
+			std::size_t m_end{};   // end of received bytes
+		};
+	}
+}
+
+#endif // FRAME_CODEC_H
@@ -0,0 +1,567 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "IoUring.h"
+#include "CancellationToken.h"
+#include "SocketException.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <unistd.h>
+
+namespace sdk {
+	namespace network {
+
+#if IO_URING_SUPPORTED
+
+		namespace {
+			constexpr const unsigned QUEUE_DEPTH = 64;
+			// The low bit of user data marks multishot accept requests.
+			constexpr const std::uintptr_t ACCEPT_TAG = 1;
+
+			thread_local std::unique_ptr<IoUring> threadRing;
+
+			// rings of all threads, so that a listener can be cancelled on the ring that armed its accept
+			struct RingRegistry {
+				std::mutex lock;
+				std::vector<IoUring*> rings;
+			};
+
+			RingRegistry& ringRegistry()
+			{
+				static RingRegistry registry;
+				return registry;
+			}
+
+			struct __kernel_timespec toTimespec(int timeoutMs) noexcept
+			{
+				struct __kernel_timespec timeout{};
+				timeout.tv_sec = timeoutMs / 1000;
+				timeout.tv_nsec = static_cast<long long>(timeoutMs % 1000) * 1000000;
+				return timeout;
+			}
+
+			int toSocketResult(int result) noexcept
+			{
+				if (result < 0) {
+					// the request is cancelled by a linked timeout
+					errno = (result == -ECANCELED || result == -ETIME) ? WSAEWOULDBLOCK : -result;
+					return SOCKET_ERROR;
+				}
+				return result;
+			}
+		}
+
+		IoUring::IoUring()
+		{
+			const int ret = io_uring_queue_init(QUEUE_DEPTH, &m_ring, 0);
+			if (ret < 0) {
+				throw general::SocketException(-ret);
+			}
+
+			auto& registry = ringRegistry();
+			std::lock_guard<std::mutex> lock(registry.lock);
+			registry.rings.push_back(this);
+		}
+
+		IoUring::~IoUring()
+		{
+			{
+				auto& registry = ringRegistry();
+				std::lock_guard<std::mutex> lock(registry.lock);
+				registry.rings.erase(std::remove(registry.rings.begin(), registry.rings.end(), this), registry.rings.end());
+			}
+
+			// pending requests are cancelled by the kernel when the ring is released.
+			io_uring_queue_exit(&m_ring);
+			for (const auto& queue : m_acceptQueues) {
+				for (const auto socketId : queue.second->sockets) {
+					closesocket(socketId);
+				}
+			}
+		}
+
+		bool IoUring::isSupported() noexcept
+		{
+			static const bool supported = []() noexcept {
+				struct io_uring ring{};
+				if (io_uring_queue_init(2, &ring, 0) < 0) {
+					return false;
+				}
+
+				bool result = false;
+				auto* probe = io_uring_get_probe_ring(&ring);
+				if (probe != nullptr) {
+					result = io_uring_opcode_supported(probe, IORING_OP_RECV) &&
+							 io_uring_opcode_supported(probe, IORING_OP_SEND) &&
+							 io_uring_opcode_supported(probe, IORING_OP_ACCEPT) &&
+							 io_uring_opcode_supported(probe, IORING_OP_CONNECT) &&
+							 io_uring_opcode_supported(probe, IORING_OP_POLL_ADD) &&
+							 io_uring_opcode_supported(probe, IORING_OP_LINK_TIMEOUT) &&
+							 io_uring_opcode_supported(probe, IORING_OP_ASYNC_CANCEL);
+					io_uring_free_probe(probe);
+				}
+				io_uring_queue_exit(&ring);
+				return result;
+			}();
+			return supported;
+		}
+
+		bool IoUring::isMultishotAcceptSupported() noexcept
+		{
+#ifdef IORING_ACCEPT_MULTISHOT
+			static const bool supported = []() noexcept {
+				// older kernels reject the flag with EINVAL, newer ones keep the request armed until it is cancelled.
+				struct io_uring ring{};
+				if (io_uring_queue_init(2, &ring, 0) < 0) {
+					return false;
+				}
+
+				bool result = false;
+				const int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+				sockaddr_in address{};
+				address.sin_family = AF_INET;
+				address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+				if (listener >= 0 &&
+					::bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0 &&
+					::listen(listener, 1) == 0) {
+					auto* sqe = io_uring_get_sqe(&ring);
+					io_uring_prep_multishot_accept(sqe, listener, nullptr, nullptr, 0);
+					io_uring_sqe_set_data(sqe, reinterpret_cast<void*>(ACCEPT_TAG));
+					sqe = io_uring_get_sqe(&ring);
+					io_uring_prep_cancel(sqe, reinterpret_cast<void*>(ACCEPT_TAG), 0);
+					io_uring_sqe_set_data(sqe, nullptr);
+
+					if (io_uring_submit(&ring) == 2) {
+						// the accept and the cancel request complete both
+						for (int count = 0; count < 2; ++count) {
+							struct io_uring_cqe* cqe = nullptr;
+							if (io_uring_wait_cqe(&ring, &cqe) < 0) {
+								break;
+							}
+							if (io_uring_cqe_get_data(cqe) != nullptr) {
+								result = cqe->res == -ECANCELED;
+							}
+							io_uring_cqe_seen(&ring, cqe);
+						}
+					}
+				}
+
+				io_uring_queue_exit(&ring);
+				if (listener >= 0) {
+					::close(listener);
+				}
+				return result;
+			}();
+			return supported;
+#else
+			return false;
+#endif
+		}
+
+		IoUring& IoUring::threadInstance()
+		{
+			if (!threadRing) {
+				threadRing.reset(new IoUring{});
+			}
+			return *threadRing;
+		}
+
+		void IoUring::cancelAccept(SOCKET socketId) noexcept
+		{
+			bool posted = false;
+			try {
+				auto& registry = ringRegistry();
+				std::lock_guard<std::mutex> lock(registry.lock);
+				for (auto* ring : registry.rings) {
+					if (ring != threadRing.get() && ring->postCancel(socketId)) {
+						posted = true;
+					}
+				}
+			}
+			catch (const std::exception&) {
+				// the queue is released with the ring
+			}
+
+			if (posted) {
+				// the rings of other threads are not thread safe, shutting down the listener
+				// completes their accept requests with an error instead.
+				shutdown(socketId, SD_RECEIVE);
+			}
+
+			if (threadRing) {
+				threadRing->cancel(socketId);
+			}
+		}
+
+		bool IoUring::postCancel(SOCKET socketId)
+		{
+			std::lock_guard<std::mutex> lock(m_cancelLock);
+			if (m_listeners.count(socketId) == 0) {
+				return false;
+			}
+			m_pendingCancels.push_back(socketId);
+			return true;
+		}
+
+		void IoUring::processCancels() noexcept
+		{
+			std::vector<SOCKET> cancels;
+			{
+				std::lock_guard<std::mutex> lock(m_cancelLock);
+				cancels.swap(m_pendingCancels);
+			}
+
+			for (const auto socketId : cancels) {
+				retire(socketId);
+			}
+		}
+
+		void IoUring::retire(SOCKET socketId) noexcept
+		{
+			const auto iter = m_acceptQueues.find(socketId);
+			if (iter == m_acceptQueues.end()) {
+				return;
+			}
+
+			auto& queue = iter->second;
+			for (const auto id : queue->sockets) {
+				closesocket(id);
+			}
+			queue->sockets.clear();
+
+			try {
+				// the socket id may be reused by a new listener, so the queue leaves the map now
+				// and is freed when its request completes.
+				if (queue->armed) {
+					queue->retired = true;
+					m_retiredQueues.push_back(std::move(queue));
+				}
+				m_acceptQueues.erase(iter);
+
+				std::lock_guard<std::mutex> lock(m_cancelLock);
+				m_listeners.erase(socketId);
+			}
+			catch (const std::exception&) {
+				// the queue is released with the ring
+			}
+		}
+
+		struct io_uring_sqe* IoUring::getSqe(unsigned count /*= 1*/)
+		{
+			// linked requests must be queued in the same submission,
+			// so make room for all of them before getting the first one.
+			if (io_uring_sq_space_left(&m_ring) < count) {
+				const int ret = io_uring_submit(&m_ring);
+				if (ret < 0) {
+					throw general::SocketException(-ret);
+				}
+			}
+
+			auto* sqe = io_uring_get_sqe(&m_ring);
+			if (sqe == nullptr) {
+				throw general::SocketException(EBUSY);
+			}
+			return sqe;
+		}
+
+		int IoUring::execute(Completion& completion, const Completion* cancelPoll /*= nullptr*/)
+		{
+			// submit and wait with a single system call
+			int ret = io_uring_submit_and_wait(&m_ring, 1);
+			if (ret < 0 && ret != -EINTR) {
+				throw general::SocketException(-ret);
+			}
+
+			while (!completion.done && (cancelPoll == nullptr || !cancelPoll->done)) {
+				struct io_uring_cqe* cqe = nullptr;
+				ret = io_uring_wait_cqe(&m_ring, &cqe);
+				if (ret == -EINTR) {
+					continue;
+				}
+				if (ret < 0) {
+					throw general::SocketException(-ret);
+				}
+				dispatch(cqe);
+			}
+
+			return completion.result;
+		}
+
+		void IoUring::armCancelPoll(const CancellationToken& cancelToken, Completion& completion)
+		{
+			// the handle of the token becomes readable when it is cancelled
+			auto* sqe = getSqe();
+			io_uring_prep_poll_add(sqe, static_cast<int>(cancelToken.getWaitHandle()), POLLIN);
+			io_uring_sqe_set_data(sqe, &completion);
+		}
+
+		void IoUring::cancelRequest(Completion& completion)
+		{
+			if (completion.done) {
+				return;
+			}
+
+			auto* sqe = getSqe();
+			io_uring_prep_cancel(sqe, &completion, 0);
+			io_uring_sqe_set_data(sqe, nullptr);
+			const int ret = io_uring_submit(&m_ring);
+			if (ret < 0) {
+				throw general::SocketException(-ret);
+			}
+
+			// the completion is owned by the caller, the kernel must not use it after it returns.
+			while (!completion.done) {
+				struct io_uring_cqe* cqe = nullptr;
+				const int waitRet = io_uring_wait_cqe(&m_ring, &cqe);
+				if (waitRet == -EINTR) {
+					continue;
+				}
+				if (waitRet < 0) {
+					throw general::SocketException(-waitRet);
+				}
+				dispatch(cqe);
+			}
+		}
+
+		void IoUring::dispatch(struct io_uring_cqe* cqe) noexcept
+		{
+			const auto userData = reinterpret_cast<std::uintptr_t>(io_uring_cqe_get_data(cqe));
+			const int result = cqe->res;
+			const auto flags = cqe->flags;
+			io_uring_cqe_seen(&m_ring, cqe);
+
+			if (userData == 0) {
+				return; // link timeouts and cancel requests
+			}
+
+			if ((userData & ACCEPT_TAG) != 0) {
+				auto* queue = reinterpret_cast<AcceptQueue*>(userData & ~ACCEPT_TAG);
+				if (queue->retired) {
+					if (result >= 0) {
+						closesocket(static_cast<SOCKET>(result));
+					}
+					if ((flags & IORING_CQE_F_MORE) == 0) {
+						m_retiredQueues.erase(std::remove_if(m_retiredQueues.begin(), m_retiredQueues.end(),
+							[queue](const std::unique_ptr<AcceptQueue>& retired) { return retired.get() == queue; }),
+							m_retiredQueues.end());
+					}
+					return;
+				}
+
+				if (result >= 0) {
+					queue->sockets.push_back(static_cast<SOCKET>(result));
+				}
+				else if (result != -ECANCELED && result != -EAGAIN) {
+					queue->error = -result;
+				}
+				if ((flags & IORING_CQE_F_MORE) == 0) {
+					queue->armed = false;
+				}
+				return;
+			}
+
+			auto* completion = reinterpret_cast<Completion*>(userData);
+			completion->result = result;
+			completion->done = true;
+		}
+
+		void IoUring::cancel(SOCKET socketId) noexcept
+		{
+			const auto iter = m_acceptQueues.find(socketId);
+			if (iter == m_acceptQueues.end()) {
+				return;
+			}
+
+			auto& queue = iter->second;
+			try {
+				if (queue->armed) {
+					auto* sqe = getSqe();
+					io_uring_prep_cancel(sqe,
+						reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(queue.get()) | ACCEPT_TAG), 0);
+					io_uring_sqe_set_data(sqe, nullptr);
+					(void)io_uring_submit(&m_ring);
+
+					// wait for the last completion, the kernel must not use the queue after it is freed.
+					while (queue->armed) {
+						struct io_uring_cqe* cqe = nullptr;
+						const int ret = io_uring_wait_cqe(&m_ring, &cqe);
+						if (ret == -EINTR) {
+							continue;
+						}
+						if (ret < 0) {
+							return; // keep the queue alive, it is released with the ring.
+						}
+						dispatch(cqe);
+					}
+				}
+			}
+			catch (const general::SocketException&) {
+				return;
+			}
+
+			for (const auto id : queue->sockets) {
+				closesocket(id);
+			}
+			m_acceptQueues.erase(iter);
+
+			try {
+				std::lock_guard<std::mutex> lock(m_cancelLock);
+				m_listeners.erase(socketId);
+			}
+			catch (const std::exception&) {
+				// a stale entry only costs a shutdown of the listener
+			}
+		}
+
+		int IoUring::recv(SOCKET socketId, char* buffer, int length, int flags, int timeoutMs /*= -1*/)
+		{
+			Completion completion;
+			struct __kernel_timespec timeout = toTimespec(timeoutMs);
+
+			auto* sqe = getSqe(timeoutMs > 0 ? 2 : 1);
+			io_uring_prep_recv(sqe, static_cast<int>(socketId), buffer, static_cast<std::size_t>(length),
+				timeoutMs == 0 ? flags | MSG_DONTWAIT : flags);
+			io_uring_sqe_set_data(sqe, &completion);
+
+			if (timeoutMs > 0) {
+				sqe->flags |= IOSQE_IO_LINK;
+				auto* timeoutSqe = getSqe();
+				io_uring_prep_link_timeout(timeoutSqe, &timeout, 0);
+				io_uring_sqe_set_data(timeoutSqe, nullptr);
+			}
+
+			return toSocketResult(execute(completion));
+		}
+
+		int IoUring::send(SOCKET socketId, const char* data, int dataSize, int flags)
+		{
+			Completion completion;
+			auto* sqe = getSqe();
+			io_uring_prep_send(sqe, static_cast<int>(socketId), data, static_cast<std::size_t>(dataSize), flags);
+			io_uring_sqe_set_data(sqe, &completion);
+			return toSocketResult(execute(completion));
+		}
+
+		int IoUring::connect(SOCKET socketId, const sockaddr* address, socklen_t addressSize,
+			const CancellationToken* cancelToken /*= nullptr*/)
+		{
+			Completion completion;
+			Completion cancelPoll;
+			auto* sqe = getSqe(cancelToken != nullptr ? 2 : 1);
+			io_uring_prep_connect(sqe, static_cast<int>(socketId), address, addressSize);
+			io_uring_sqe_set_data(sqe, &completion);
+			if (cancelToken == nullptr) {
+				return toSocketResult(execute(completion));
+			}
+
+			armCancelPoll(*cancelToken, cancelPoll);
+			(void)execute(completion, &cancelPoll);
+
+			// the request that is still pending is cancelled, the connect with ECANCELED if the token won
+			cancelRequest(completion);
+			cancelRequest(cancelPoll);
+			return toSocketResult(completion.result);
+		}
+
+		SOCKET IoUring::accept(SOCKET socketId, int timeoutMs, const CancellationToken* cancelToken /*= nullptr*/)
+		{
+			processCancels();
+
+			auto& queue = m_acceptQueues[socketId];
+			if (!queue) {
+				queue.reset(new AcceptQueue{});
+				std::lock_guard<std::mutex> lock(m_cancelLock);
+				m_listeners.insert(socketId);
+			}
+
+			if (queue->sockets.empty() && queue->error == 0) {
+				const bool arming = !queue->armed;
+				if (arming) {
+					auto* sqe = getSqe();
+					// a single shot request completes once, it is armed again by the next call
+#ifdef IORING_ACCEPT_MULTISHOT
+					if (isMultishotAcceptSupported()) {
+						io_uring_prep_multishot_accept(sqe, static_cast<int>(socketId), nullptr, nullptr, 0);
+					}
+					else
+#endif
+					{
+						io_uring_prep_accept(sqe, static_cast<int>(socketId), nullptr, nullptr, 0);
+					}
+					io_uring_sqe_set_data(sqe,
+						reinterpret_cast<void*>(reinterpret_cast<std::uintptr_t>(queue.get()) | ACCEPT_TAG));
+					queue->armed = true;
+				}
+
+				//	the token is watched by the ring next to the accept, a cancellation ends the wait
+				Completion cancelPoll;
+				if (cancelToken != nullptr) {
+					armCancelPoll(*cancelToken, cancelPoll);
+				}
+
+				const int ret = io_uring_submit(&m_ring);
+				if (ret < 0) {
+					if (arming) {
+						queue->armed = false;
+					}
+					throw general::SocketException(-ret);
+				}
+
+				struct __kernel_timespec timeout = toTimespec(timeoutMs);
+				while (queue->sockets.empty() && queue->error == 0 && !cancelPoll.done) {
+					struct io_uring_cqe* cqe = nullptr;
+					const int ret = io_uring_wait_cqe_timeout(&m_ring, &cqe, timeoutMs < 0 ? nullptr : &timeout);
+					if (ret == -ETIME) {
+						break;
+					}
+					if (ret == -EINTR) {
+						continue;
+					}
+					if (ret < 0) {
+						throw general::SocketException(-ret);
+					}
+					dispatch(cqe);
+				}
+
+				if (cancelToken != nullptr) {
+					cancelRequest(cancelPoll);
+				}
+			}
+
+			if (!queue->sockets.empty()) {
+				const auto newSockId = queue->sockets.front();
+				queue->sockets.pop_front();
+				return newSockId;
+			}
+
+			errno = queue->error != 0 ? queue->error : WSAEWOULDBLOCK;
+			queue->error = 0;
+			return INVALID_SOCKET;
+		}
+#endif // IO_URING_SUPPORTED
+	}
+}
@@ -0,0 +1,181 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef IO_URING_H
+#define IO_URING_H
+
+#include "SocketDescriptor.h"
+
+#if IO_URING_SUPPORTED
+#include <liburing.h>
+#endif // IO_URING_SUPPORTED
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace sdk {
+	namespace network {
+
+#if IO_URING_SUPPORTED
+
+		class CancellationToken; // forward declaration
+
+		/**
+		 * @brief IoUring class is an io_uring based I/O engine for socket operations.
+		 * @details Each thread uses its own ring, so a ring is never shared between threads.
+		 *	The functions behave like the related system calls, they return SOCKET_ERROR (or INVALID_SOCKET)
+		 *	and set errno if an error occurs. Accept operations use a multishot accept request if the kernel
+		 *	supports it, so that connections waiting in the backlog are accepted without another system call.
+		 *	Otherwise a single shot accept request is submitted for each connection.
+		 */
+		class SOCKET_API IoUring {
+		public:
+			IoUring();
+			~IoUring();
+
+			// non copyable
+			IoUring(const IoUring&) = delete;
+			IoUring& operator=(const IoUring&) = delete;
+
+			/**
+			 * @brief Checks if the running kernel supports the io_uring operations we need.
+			 * @return true if supported, false otherwise.
+			 * @exception This function never throws an exception.
+			 */
+			static bool isSupported() noexcept;
+
+			/**
+			 * @brief Checks if the running kernel supports multishot accept requests (Linux 5.19 and later).
+			 * The kernel is probed once by arming a multishot accept on a temporary listening socket.
+			 * @return true if supported, false otherwise.
+			 * @exception This function never throws an exception.
+			 */
+			static bool isMultishotAcceptSupported() noexcept;
+
+			/**
+			 * @brief Gets the ring of the calling thread, the ring is created on first use.
+			 * @return The ring of the calling thread.
+			 * @exception this function throws an SocketException if the ring cannot be created.
+			 */
+			static IoUring& threadInstance();
+
+			/**
+			 * @brief Cancels the pending accept requests of a listening socket on every ring.
+			 * The request on the ring of the calling thread is cancelled synchronously. The rings of other
+			 * threads cannot be used from here, so the listening socket is shut down to complete their
+			 * requests and the rings drop their queues before their next accept.
+			 * Connections that are accepted but not returned yet are closed.
+			 * Call it before the listening socket is closed.
+			 * @param socketId The id of listening socket.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			static void cancelAccept(SOCKET socketId) noexcept;
+
+			/**
+			 * @brief Receives data from a socket.
+			 * @param socketId The id of socket.
+			 * @param buffer The buffer that data is written to.
+			 * @param length Size of buffer.
+			 * @param flags Flags of recv, MSG_DONTWAIT returns immediately if no data is available.
+			 * @param timeoutMs Wait timeout in milliseconds, -1 waits infinitely.
+			 * @return Return byte count that read, SOCKET_ERROR with WSAEWOULDBLOCK if the timeout expired.
+			 * @exception this function throws an SocketException if the ring fails.
+			 */
+			NODISCARD int recv(SOCKET socketId, char* buffer, int length, int flags, int timeoutMs = -1);
+
+			/**
+			 * @brief Sends data to a socket.
+			 * @param socketId The id of socket.
+			 * @param data Bytes of message.
+			 * @param dataSize Size of message.
+			 * @param flags Flags of send.
+			 * @return Return byte count that write, SOCKET_ERROR if an error occurs.
+			 * @exception this function throws an SocketException if the ring fails.
+			 */
+			NODISCARD int send(SOCKET socketId, const char* data, int dataSize, int flags);
+
+			/**
+			 * @brief Accepts a connection from a listening socket.
+			 * @param socketId The id of listening socket.
+			 * @param timeoutMs Wait timeout in milliseconds, -1 waits infinitely.
+			 * @param cancelToken The wait also ends when the token is cancelled, it may be null.
+			 * @return The id of accepted socket, INVALID_SOCKET with WSAEWOULDBLOCK if the timeout expired
+			 *	or the token is cancelled.
+			 * @exception this function throws an SocketException if the ring fails.
+			 */
+			NODISCARD SOCKET accept(SOCKET socketId, int timeoutMs, const CancellationToken* cancelToken = nullptr);
+
+			/**
+			 * @brief Connects a socket to the given address and waits until the connection completes.
+			 * @param socketId The id of socket.
+			 * @param address The address of the server.
+			 * @param addressSize Size of address.
+			 * @param cancelToken The connection attempt is cancelled with the token, it may be null.
+			 * @return 0 if successfully, SOCKET_ERROR otherwise, with WSAEWOULDBLOCK if the token is cancelled.
+			 * @exception this function throws an SocketException if the ring fails.
+			 */
+			NODISCARD int connect(SOCKET socketId, const sockaddr* address, socklen_t addressSize,
+				const CancellationToken* cancelToken = nullptr);
+
+		private:
+			struct Completion {
+				int result{};
+				bool done{};
+			};
+
+			struct AcceptQueue {
+				std::deque<SOCKET> sockets;
+				int error{};
+				bool armed{};
+				bool retired{};
+			};
+
+			struct io_uring_sqe* getSqe(unsigned count = 1);
+			int execute(Completion& completion, const Completion* cancelPoll = nullptr);
+			void armCancelPoll(const CancellationToken& cancelToken, Completion& completion);
+			void cancelRequest(Completion& completion);
+			void dispatch(struct io_uring_cqe* cqe) noexcept;
+			void cancel(SOCKET socketId) noexcept;
+			void retire(SOCKET socketId) noexcept;
+			void processCancels() noexcept;
+			bool postCancel(SOCKET socketId);
+
+			struct io_uring m_ring{};
+			std::unordered_map<SOCKET, std::unique_ptr<AcceptQueue>> m_acceptQueues;
+			// queues whose listener is cancelled by another thread, kept until their last completion
+			std::vector<std::unique_ptr<AcceptQueue>> m_retiredQueues;
+
+			// shared with the threads that cancel accepts of this ring
+			std::mutex m_cancelLock;
+			std::unordered_set<SOCKET> m_listeners;
+			std::vector<SOCKET> m_pendingCancels;
+		};
+#endif // IO_URING_SUPPORTED
+	}
+}
+
+#endif // IO_URING_H
@@ -0,0 +1,83 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "PeerAddress.h"
+#include "SocketException.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace sdk {
+	namespace network {
+
+		PeerAddress::PeerAddress(const std::string& ipAddress, int portNumber)
+		{
+			auto* ipv4 = reinterpret_cast<sockaddr_in*>(&m_storage);
+			auto* ipv6 = reinterpret_cast<sockaddr_in6*>(&m_storage);
+
+			if (inet_pton(AF_INET, ipAddress.c_str(), &ipv4->sin_addr) == 1) {
+				ipv4->sin_family = AF_INET;
+				ipv4->sin_port = htons(static_cast<std::uint16_t>(portNumber));
+				m_size = sizeof(sockaddr_in);
+			}
+			else if (inet_pton(AF_INET6, ipAddress.c_str(), &ipv6->sin6_addr) == 1) {
+				ipv6->sin6_family = AF_INET6;
+				ipv6->sin6_port = htons(static_cast<std::uint16_t>(portNumber));
+				m_size = sizeof(sockaddr_in6);
+			}
+			else {
+				throw general::SocketException("Invalid peer address: " + ipAddress);
+			}
+		}
+
+		PeerAddress::PeerAddress(const sockaddr* address, socklen_t addressSize) noexcept :
+			m_size{ addressSize < static_cast<socklen_t>(sizeof(m_storage)) ? addressSize : static_cast<socklen_t>(sizeof(m_storage)) }
+		{
+			std::memcpy(&m_storage, address, static_cast<std::size_t>(m_size));
+		}
+
+		std::string PeerAddress::getIpAddress() const
+		{
+			char address[INET6_ADDRSTRLEN]{};
+			if (m_storage.ss_family == AF_INET) {
+				auto* ipv4 = reinterpret_cast<const sockaddr_in*>(&m_storage);
+				inet_ntop(AF_INET, const_cast<in_addr*>(&ipv4->sin_addr), address, sizeof(address));
+			}
+			else if (m_storage.ss_family == AF_INET6) {
+				auto* ipv6 = reinterpret_cast<const sockaddr_in6*>(&m_storage);
+				inet_ntop(AF_INET6, const_cast<in6_addr*>(&ipv6->sin6_addr), address, sizeof(address));
+			}
+			return address;
+		}
+
+		int PeerAddress::getPort() const noexcept
+		{
+			if (m_storage.ss_family == AF_INET) {
+				return ntohs(reinterpret_cast<const sockaddr_in*>(&m_storage)->sin_port);
+			}
+			if (m_storage.ss_family == AF_INET6) {
+				return ntohs(reinterpret_cast<const sockaddr_in6*>(&m_storage)->sin6_port);
+			}
+			return 0;
+		}
+	}
+}
@@ -0,0 +1,97 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef PEER_ADDRESS_H
+#define PEER_ADDRESS_H
+
+#include "SocketDescriptor.h"
+
+#include <string>
+
+namespace sdk {
+	namespace network {
+
+		/**
+		 * @brief PeerAddress class stores an IPv4 or IPv6 address and port of a datagram peer.
+		 */
+		class SOCKET_API PeerAddress {
+		public:
+			PeerAddress() noexcept = default;
+
+			/**
+			 * @brief Creates an address from its numeric form.
+			 * @param ipAddress Numeric IPv4 or IPv6 address.
+			 * @param portNumber Port number.
+			 * @exception this function throws an SocketException if the address is not valid.
+			 */
+			PeerAddress(const std::string& ipAddress, int portNumber);
+
+			/**
+			 * @brief Creates an address from a socket address structure.
+			 * @param address The socket address.
+			 * @param addressSize Size of the socket address.
+			 * @exception This function never throws an exception.
+			 */
+			PeerAddress(const sockaddr* address, socklen_t addressSize) noexcept;
+
+			NODISCARD sockaddr* data() noexcept
+			{
+				return reinterpret_cast<sockaddr*>(&m_storage);
+			}
+
+			NODISCARD const sockaddr* data() const noexcept
+			{
+				return reinterpret_cast<const sockaddr*>(&m_storage);
+			}
+
+			NODISCARD socklen_t size() const noexcept
+			{
+				return m_size;
+			}
+
+			void setSize(socklen_t size) noexcept
+			{
+				m_size = size;
+			}
+
+			/**
+			 * @brief Gets the address in its numeric form.
+			 * @return The address, an empty string if it is not set.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD std::string getIpAddress() const;
+
+			/**
+			 * @brief Gets the port number of the address.
+			 * @return The port number, 0 if it is not set.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD int getPort() const noexcept;
+
+		private:
+			sockaddr_storage m_storage{};
+			socklen_t m_size{};
+		};
+	}
+}
+
+#endif // PEER_ADDRESS_H
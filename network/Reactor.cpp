@@ -0,0 +1,400 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Reactor.h"
+#include "SocketException.h"
+
+#ifdef __linux__
+#include <sys/eventfd.h>
+#include <poll.h>
+#endif
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+
+namespace sdk {
+	namespace network {
+
+		namespace {
+			constexpr const auto MAX_EVENTS = 256;
+
+#ifdef _WIN32
+			int pollSockets(WSAPOLLFD* fds, std::size_t count, int timeoutMs)
+			{
+				return WSAPoll(fds, static_cast<ULONG>(count), timeoutMs);
+			}
+
+			bool isInterrupted() noexcept
+			{
+				return false;
+			}
+#else
+			int pollSockets(struct pollfd* fds, std::size_t count, int timeoutMs)
+			{
+				return ::poll(fds, static_cast<nfds_t>(count), timeoutMs);
+			}
+
+			bool isInterrupted() noexcept
+			{
+				return errno == EINTR;
+			}
+#endif
+
+			short toPollEvents(std::uint32_t events) noexcept
+			{
+				short pollEvents = 0;
+				if ((events & EVENT_READ) != 0) {
+					pollEvents |= POLLIN;
+				}
+				if ((events & EVENT_WRITE) != 0) {
+					pollEvents |= POLLOUT;
+				}
+				return pollEvents;
+			}
+
+			std::uint32_t fromPollEvents(short pollEvents) noexcept
+			{
+				std::uint32_t events = EVENT_NONE;
+				if ((pollEvents & (POLLIN | POLLHUP)) != 0) {
+					events |= EVENT_READ;
+				}
+				if ((pollEvents & POLLOUT) != 0) {
+					events |= EVENT_WRITE;
+				}
+				if ((pollEvents & (POLLERR | POLLNVAL)) != 0) {
+					events |= EVENT_ERROR;
+				}
+				return events;
+			}
+
+#ifdef __linux__
+			std::uint32_t toEpollEvents(std::uint32_t events) noexcept
+			{
+				std::uint32_t epollEvents = 0;
+				if ((events & EVENT_READ) != 0) {
+					epollEvents |= EPOLLIN | EPOLLRDHUP;
+				}
+				if ((events & EVENT_WRITE) != 0) {
+					epollEvents |= EPOLLOUT;
+				}
+				return epollEvents;
+			}
+
+			std::uint32_t fromEpollEvents(std::uint32_t epollEvents) noexcept
+			{
+				std::uint32_t events = EVENT_NONE;
+				if ((epollEvents & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) != 0) {
+					events |= EVENT_READ;
+				}
+				if ((epollEvents & EPOLLOUT) != 0) {
+					events |= EVENT_WRITE;
+				}
+				if ((epollEvents & EPOLLERR) != 0) {
+					events |= EVENT_ERROR;
+				}
+				return events;
+			}
+#endif
+		}
+
+		Reactor::Reactor()
+		{
+#ifdef __linux__
+			m_epollFd = epoll_create1(EPOLL_CLOEXEC);
+			if (m_epollFd < 0) {
+				throw general::SocketException(errno);
+			}
+
+			m_wakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+			if (m_wakeupFd < 0) {
+				const auto err = errno;
+				close(m_epollFd);
+				throw general::SocketException(err);
+			}
+
+			struct epoll_event event{};
+			event.events = EPOLLIN;
+			event.data.fd = m_wakeupFd;
+			if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, m_wakeupFd, &event) < 0) {
+				const auto err = errno;
+				close(m_wakeupFd);
+				close(m_epollFd);
+				throw general::SocketException(err);
+			}
+
+			m_events.resize(MAX_EVENTS);
+#else
+			// A udp socket connected to itself is used to wake up the poll,
+			// it works with both poll and WSAPoll.
+			m_wakeupSocket = socket(AF_INET, SOCK_DGRAM, 0);
+			if (m_wakeupSocket == INVALID_SOCKET) {
+				throw general::SocketException(WSAGetLastError());
+			}
+
+			struct sockaddr_in address{};
+			address.sin_family = AF_INET;
+			address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			socklen_t addressSize = sizeof(address);
+			unsigned long nonBlocking = 1;
+
+			if (::bind(m_wakeupSocket, reinterpret_cast<const sockaddr*>(&address), addressSize) == SOCKET_ERROR ||
+				getsockname(m_wakeupSocket, reinterpret_cast<sockaddr*>(&address), &addressSize) == SOCKET_ERROR ||
+				::connect(m_wakeupSocket, reinterpret_cast<const sockaddr*>(&address), addressSize) == SOCKET_ERROR ||
+				ioctlsocket(m_wakeupSocket, FIONBIO, &nonBlocking) == SOCKET_ERROR) {
+				const auto err = WSAGetLastError();
+				closesocket(m_wakeupSocket);
+				throw general::SocketException(err);
+			}
+#endif
+		}
+
+		Reactor::~Reactor()
+		{
+#ifdef __linux__
+			close(m_wakeupFd);
+			close(m_epollFd);
+#else
+			closesocket(m_wakeupSocket);
+#endif
+		}
+
+		void Reactor::add(SOCKET socketId, std::uint32_t events, ReactorCallback callback)
+		{
+			if (m_handlers.find(socketId) != m_handlers.end()) {
+				throw general::SocketException("The socket is already registered to the reactor.");
+			}
+
+#ifdef __linux__
+			struct epoll_event event{};
+			event.events = toEpollEvents(events);
+			event.data.fd = static_cast<int>(socketId);
+			if (epoll_ctl(m_epollFd, EPOLL_CTL_ADD, static_cast<int>(socketId), &event) < 0) {
+				throw general::SocketException(errno);
+			}
+#endif
+			auto handler = std::make_shared<Handler>();
+			handler->events = events;
+			handler->callback = std::move(callback);
+			m_handlers.emplace(socketId, std::move(handler));
+		}
+
+		void Reactor::modify(SOCKET socketId, std::uint32_t events)
+		{
+			const auto iter = m_handlers.find(socketId);
+			if (iter == m_handlers.end()) {
+				throw general::SocketException("The socket is not registered to the reactor.");
+			}
+
+#ifdef __linux__
+			struct epoll_event event{};
+			event.events = toEpollEvents(events);
+			event.data.fd = static_cast<int>(socketId);
+			if (epoll_ctl(m_epollFd, EPOLL_CTL_MOD, static_cast<int>(socketId), &event) < 0) {
+				throw general::SocketException(errno);
+			}
+#endif
+			iter->second->events = events;
+		}
+
+		void Reactor::remove(SOCKET socketId) noexcept
+		{
+			const auto iter = m_handlers.find(socketId);
+			if (iter == m_handlers.end()) {
+				return;
+			}
+
+#ifdef __linux__
+			// the socket may already be closed, the error is not important.
+			struct epoll_event event{};
+			(void)epoll_ctl(m_epollFd, EPOLL_CTL_DEL, static_cast<int>(socketId), &event);
+#endif
+			m_handlers.erase(iter);
+		}
+
+		std::size_t Reactor::runOnce(int timeoutMs)
+		{
+			std::size_t dispatched = 0;
+
+			const int timerTimeoutMs = m_timers.getNextTimeoutMs();
+			if (timerTimeoutMs >= 0 && (timeoutMs < 0 || timerTimeoutMs < timeoutMs)) {
+				timeoutMs = timerTimeoutMs;
+			}
+
+#ifdef __linux__
+			const int count = epoll_wait(m_epollFd, m_events.data(), static_cast<int>(m_events.size()), timeoutMs);
+			if (count < 0) {
+				if (isInterrupted()) {
+					return dispatched;
+				}
+				throw general::SocketException(errno);
+			}
+
+			for (int i = 0; i < count; ++i) {
+				const auto socketId = static_cast<SOCKET>(m_events[i].data.fd);
+				if (m_events[i].data.fd == m_wakeupFd) {
+					drainWakeup();
+					continue;
+				}
+
+				const auto iter = m_handlers.find(socketId);
+				if (iter == m_handlers.end()) {
+					continue; // removed by a previous callback
+				}
+
+				// keep the handler alive even if the callback removes itself
+				const auto handler = iter->second;
+				const auto events = fromEpollEvents(m_events[i].events) & (handler->events | EVENT_ERROR);
+				if (events != EVENT_NONE) {
+					handler->callback(socketId, events);
+					++dispatched;
+				}
+			}
+#else
+			m_pollFds.clear();
+			struct pollfd wakeupFd{};
+			wakeupFd.fd = m_wakeupSocket;
+			wakeupFd.events = POLLIN;
+			m_pollFds.push_back(wakeupFd);
+
+			for (const auto& handler : m_handlers) {
+				struct pollfd pollFd{};
+				pollFd.fd = handler.first;
+				pollFd.events = toPollEvents(handler.second->events);
+				m_pollFds.push_back(pollFd);
+			}
+
+			const int count = pollSockets(m_pollFds.data(), m_pollFds.size(), timeoutMs);
+			if (count < 0) {
+				if (isInterrupted()) {
+					return dispatched;
+				}
+				throw general::SocketException(WSAGetLastError());
+			}
+
+			if (m_pollFds[0].revents != 0) {
+				drainWakeup();
+			}
+
+			for (std::size_t i = 1; i < m_pollFds.size(); ++i) {
+				if (m_pollFds[i].revents == 0) {
+					continue;
+				}
+
+				const auto socketId = static_cast<SOCKET>(m_pollFds[i].fd);
+				const auto iter = m_handlers.find(socketId);
+				if (iter == m_handlers.end()) {
+					continue; // removed by a previous callback
+				}
+
+				// keep the handler alive even if the callback removes itself
+				const auto handler = iter->second;
+				const auto events = fromPollEvents(m_pollFds[i].revents) & (handler->events | EVENT_ERROR);
+				if (events != EVENT_NONE) {
+					handler->callback(socketId, events);
+					++dispatched;
+				}
+			}
+#endif
+			dispatched += m_timers.advance();
+			return dispatched;
+		}
+
+		void Reactor::run()
+		{
+			while (!m_stopped) {
+				(void)runOnce(-1);
+			}
+			m_stopped = false;
+		}
+
+		void Reactor::stop() noexcept
+		{
+			m_stopped = true;
+			wakeup();
+		}
+
+		void Reactor::wakeup() noexcept
+		{
+#ifdef __linux__
+			const std::uint64_t value = 1;
+			(void)write(m_wakeupFd, &value, sizeof(value));
+#else
+			const char value = 1;
+			(void)send(m_wakeupSocket, &value, sizeof(value), 0);
+#endif
+		}
+
+		void Reactor::drainWakeup() noexcept
+		{
+#ifdef __linux__
+			std::uint64_t value{};
+			(void)read(m_wakeupFd, &value, sizeof(value));
+#else
+			char buffer[64];
+			while (recv(m_wakeupSocket, buffer, sizeof(buffer), 0) > 0) {
+			}
+#endif
+		}
+
+		std::uint32_t Reactor::waitFor(SOCKET socketId, std::uint32_t events, int timeoutMs,
+			const CancellationToken* cancelToken /*= nullptr*/)
+		{
+			//	the handle of the token is watched next to the socket
+			struct pollfd pollFds[2]{};
+			pollFds[0].fd = socketId;
+			pollFds[0].events = toPollEvents(events);
+			std::size_t pollCount = 1;
+			if (cancelToken != nullptr) {
+				pollFds[1].fd = cancelToken->getWaitHandle();
+				pollFds[1].events = POLLIN;
+				pollCount = 2;
+			}
+
+			//	a signal restarts the wait with the time that is left, so signals cannot stretch it
+			const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{ timeoutMs };
+			int ret{};
+			while ((ret = pollSockets(pollFds, pollCount, timeoutMs)) < 0) {
+				if (!isInterrupted()) {
+					throw general::SocketException(WSAGetLastError());
+				}
+
+				if (timeoutMs > 0) {
+					const auto remaining = deadline - std::chrono::steady_clock::now();
+					const auto remainingMs = std::chrono::duration_cast<std::chrono::milliseconds>(remaining +
+						std::chrono::milliseconds{ 1 } - std::chrono::steady_clock::duration{ 1 }).count();
+					timeoutMs = static_cast<int>((std::max)(remainingMs, static_cast<std::chrono::milliseconds::rep>(0)));
+				}
+			}
+
+			if (cancelToken != nullptr && cancelToken->isCancelled()) {
+				throw general::SocketException(CANCEL_MSG);
+			}
+
+			if (ret == 0) {
+				return EVENT_NONE;
+			}
+
+			return fromPollEvents(pollFds[0].revents) & (events | EVENT_ERROR);
+		}
+	}
+}
@@ -0,0 +1,187 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef REACTOR_H
+#define REACTOR_H
+
+#include "SocketDescriptor.h"
+#include "CancellationToken.h"
+#include "TimerWheel.h"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include <atomic>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#elif !defined(_WIN32)
+#include <poll.h>
+#endif
+
+namespace sdk {
+	namespace network {
+
+		// Readiness events that can be watched on a socket.
+		enum : std::uint32_t {
+			EVENT_NONE = 0,
+			EVENT_READ = 1,
+			EVENT_WRITE = 2,
+			EVENT_ERROR = 4
+		};
+
+		//	reactor callback, invoked with the socket id and the ready events
+		using ReactorCallback = std::function<void(SOCKET, std::uint32_t)>;
+
+		/**
+		 * @brief Reactor class multiplexes readiness events of many sockets in a single wait.
+		 * @details The reactor uses epoll on Linux and poll (WSAPoll on Windows) on other platforms,
+		 *	so it is not limited by FD_SETSIZE. Registered callbacks are invoked on the thread
+		 *	that calls runOnce() or run(). The callbacks may add, modify or remove registrations.
+		 *	The timers of the reactor are fired on the same thread, the wait ends when the next one is due.
+		 */
+		class SOCKET_API Reactor {
+		public:
+			Reactor();
+			virtual ~Reactor();
+
+			// non copyable
+			Reactor(const Reactor&) = delete;
+			Reactor& operator=(const Reactor&) = delete;
+
+			/**
+			 * @brief Registers a socket to be watched for the given events.
+			 * @param socketId The id of socket.
+			 * @param events Combination of EVENT_READ and EVENT_WRITE.
+			 * @param callback The function that is called when the socket is ready.
+			 * @return nothing.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			void add(SOCKET socketId, std::uint32_t events, ReactorCallback callback);
+
+			/**
+			 * @brief Changes the events watched on a registered socket.
+			 * @param socketId The id of socket.
+			 * @param events Combination of EVENT_READ and EVENT_WRITE.
+			 * @return nothing.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			void modify(SOCKET socketId, std::uint32_t events);
+
+			/**
+			 * @brief Removes a socket from the reactor. Unknown sockets are ignored.
+			 * @param socketId The id of socket.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void remove(SOCKET socketId) noexcept;
+
+			/**
+			 * @brief Waits once for readiness events and dispatches them, then fires the expired timers.
+			 * @param timeoutMs Wait timeout in milliseconds, -1 waits infinitely. It is shortened
+			 *	when a timer is due earlier.
+			 * @return The number of callbacks that were invoked, including the timer callbacks.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			std::size_t runOnce(int timeoutMs);
+
+			/**
+			 * @brief Dispatches readiness events until stop() is called.
+			 * @return nothing.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			void run();
+
+			/**
+			 * @brief Stops the run() loop. It is safe to call from any thread.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void stop() noexcept;
+
+			/**
+			 * @brief Wakes up a thread that is blocked in runOnce().
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void wakeup() noexcept;
+
+			/**
+			 * @brief Gets the number of registered sockets.
+			 * @return The number of registered sockets.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD std::size_t size() const noexcept
+			{
+				return m_handlers.size();
+			}
+
+			/**
+			 * @brief Gets the timers that are fired by runOnce(). They must be used only on the
+			 *	thread that runs the reactor.
+			 * @return The timer wheel of the reactor.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD TimerWheel& getTimers() noexcept
+			{
+				return m_timers;
+			}
+
+			/**
+			 * @brief Waits until a single socket is ready for the given events.
+			 * This function is used instead of select() for single socket waits.
+			 * @param socketId The id of socket.
+			 * @param events Combination of EVENT_READ and EVENT_WRITE.
+			 * @param timeoutMs Wait timeout in milliseconds, -1 waits infinitely.
+			 * @param cancelToken Optional token that aborts the wait when it is cancelled.
+			 * @return The ready events, EVENT_NONE if the timeout expired.
+			 * @exception this function throws an SocketException if an error occurs or the token is cancelled.
+			 */
+			NODISCARD static std::uint32_t waitFor(SOCKET socketId, std::uint32_t events, int timeoutMs,
+				const CancellationToken* cancelToken = nullptr);
+
+		private:
+			struct Handler {
+				std::uint32_t events{};
+				ReactorCallback callback;
+			};
+
+			void drainWakeup() noexcept;
+
+			std::unordered_map<SOCKET, std::shared_ptr<Handler>> m_handlers;
+			std::atomic<bool> m_stopped{ false };
+			TimerWheel m_timers;
+#ifdef __linux__
+			int m_epollFd{ -1 };
+			int m_wakeupFd{ -1 };
+			std::vector<struct epoll_event> m_events;
+#else
+			SOCKET m_wakeupSocket{ INVALID_SOCKET }; // self connected udp socket
+			std::vector<struct pollfd> m_pollFds;
+#endif
+		};
+	}
+}
+
+#endif // REACTOR_H
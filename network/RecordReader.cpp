@@ -0,0 +1,221 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "RecordReader.h"
+#include "SocketException.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RECORD_SCAN_X86 1
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#define RECORD_SCAN_NEON 1
+#include <arm_neon.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+namespace sdk {
+	namespace network {
+
+		namespace {
+			constexpr const std::size_t MIN_READ_SIZE = 4096; // free space that is requested from each read
+
+			inline unsigned countTrailingZeros(std::uint64_t value) noexcept
+			{
+#ifdef _MSC_VER
+				unsigned long index = 0;
+				if (_BitScanForward(&index, static_cast<unsigned long>(value))) {
+					return static_cast<unsigned>(index);
+				}
+				(void)_BitScanForward(&index, static_cast<unsigned long>(value >> 32));
+				return static_cast<unsigned>(index) + 32;
+#else
+				return static_cast<unsigned>(__builtin_ctzll(value));
+#endif
+			}
+
+			const char* findByteScalar(const char* begin, const char* end, char value) noexcept
+			{
+				const auto* found = static_cast<const char*>(std::memchr(begin, value, static_cast<std::size_t>(end - begin)));
+				return found != nullptr ? found : end;
+			}
+
+#if RECORD_SCAN_X86
+			const char* findByteSse2(const char* begin, const char* end, char value) noexcept
+			{
+				const __m128i needle = _mm_set1_epi8(value);
+				for (; end - begin >= 16; begin += 16) {
+					const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+					const auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+					if (mask != 0) {
+						return begin + countTrailingZeros(mask);
+					}
+				}
+				return findByteScalar(begin, end, value);
+			}
+
+			TARGET_AVX2 const char* findByteAvx2(const char* begin, const char* end, char value) noexcept
+			{
+				const __m256i needle = _mm256_set1_epi8(value);
+				for (; end - begin >= 32; begin += 32) {
+					const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+					const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+					if (mask != 0) {
+						return begin + countTrailingZeros(mask);
+					}
+				}
+				return findByteSse2(begin, end, value);
+			}
+
+			bool isAvx2Supported() noexcept
+			{
+#ifdef _MSC_VER
+				int info[4]{};
+				__cpuid(info, 0);
+				if (info[0] < 7) {
+					return false;
+				}
+				__cpuid(info, 1);
+				const bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+				__cpuidex(info, 7, 0);
+				return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#else
+				return __builtin_cpu_supports("avx2") != 0;
+#endif
+			}
+#endif // RECORD_SCAN_X86
+
+#if RECORD_SCAN_NEON
+			const char* findByteNeon(const char* begin, const char* end, char value) noexcept
+			{
+				const uint8x16_t needle = vdupq_n_u8(static_cast<std::uint8_t>(value));
+				for (; end - begin >= 16; begin += 16) {
+					const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const std::uint8_t*>(begin));
+					const uint8x16_t equal = vceqq_u8(chunk, needle);
+					// narrow every byte of the comparison to a nibble of a 64 bit mask
+					const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(equal), 4);
+					const std::uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(narrowed), 0);
+					if (mask != 0) {
+						return begin + countTrailingZeros(mask) / 4;
+					}
+				}
+				return findByteScalar(begin, end, value);
+			}
+#endif // RECORD_SCAN_NEON
+
+			using FindByteFunc = const char* (*)(const char*, const char*, char);
+
+			FindByteFunc selectFindByte() noexcept
+			{
+#if RECORD_SCAN_X86
+				return isAvx2Supported() ? findByteAvx2 : findByteSse2;
+#elif RECORD_SCAN_NEON
+				return findByteNeon;
+#else
+				return findByteScalar;
+#endif
+			}
+
+			const FindByteFunc findByteImpl = selectFindByte();
+		}
+
+		RecordReader::RecordReader(SocketDescriptor& descriptor, std::string delimiter /*= "\n"*/,
+			std::size_t maxRecordSize /*= DEFAULT_MAX_RECORD_SIZE*/) :
+			m_descriptor{ descriptor },
+			m_delimiter{ std::move(delimiter) },
+			m_maxRecordSize{ maxRecordSize }
+		{
+			if (m_delimiter.empty()) {
+				throw general::SocketException("The record delimiter is empty.");
+			}
+		}
+
+		bool RecordReader::readRecord(std::string& record)
+		{
+			const auto delimiterSize = m_delimiter.size();
+
+			while (true) {
+				//	look for a delimiter in the bytes that are not scanned yet
+				const char* data = m_buffer.data();
+				while (m_scanPos < m_end) {
+					const char* found = findByte(data + m_scanPos, data + m_end, m_delimiter[0]);
+					const auto position = static_cast<std::size_t>(found - data);
+					if (position == m_end || position + delimiterSize > m_end) {
+						m_scanPos = position; // a delimiter may start here, check it when more data arrives
+						break;
+					}
+
+					if (std::memcmp(found, m_delimiter.data(), delimiterSize) == 0) {
+						record.assign(data + m_begin, position - m_begin);
+						m_begin = m_scanPos = position + delimiterSize;
+						if (m_begin == m_end) {
+							m_begin = m_end = m_scanPos = 0;
+						}
+						return true;
+					}
+					m_scanPos = position + 1;
+				}
+
+				if (getBufferedSize() >= m_maxRecordSize) {
+					throw general::SocketException("No delimiter is found within the maximum record size.");
+				}
+
+				//	make room for more data, the consumed bytes are dropped first
+				if (m_begin > 0) {
+					std::memmove(m_buffer.data(), m_buffer.data() + m_begin, getBufferedSize());
+					m_end -= m_begin;
+					m_scanPos -= m_begin;
+					m_begin = 0;
+				}
+
+				if (m_buffer.size() - m_end < MIN_READ_SIZE) {
+					m_buffer.resize((std::max)(m_buffer.size() * 2, m_end + MIN_READ_SIZE));
+				}
+
+				//	a single receive per call, it waits up to the receive timeout for data
+				const MutableBuffer buffer{ m_buffer.data() + m_end, m_buffer.size() - m_end };
+				const auto receiveByte = m_descriptor.scatterRead(&buffer, 1);
+				if (receiveByte == 0) {
+					return false;
+				}
+				m_end += receiveByte;
+			}
+		}
+
+		const char* RecordReader::findByte(const char* begin, const char* end, char value) noexcept
+		{
+			return findByteImpl(begin, end, value);
+		}
+	}
+}
@@ -0,0 +1,94 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef RECORD_READER_H
+#define RECORD_READER_H
+
+#include "SocketDescriptor.h"
+
+#include <string>
+#include <vector>
+
+namespace sdk {
+	namespace network {
+
+		/**
+		 * @brief RecordReader class returns delimited records such as lines from a descriptor.
+		 * @details Received bytes are scanned for the delimiter with SIMD instructions (SSE2 or
+		 *	AVX2 on x86, NEON on ARM) when available. The bytes after a record are kept for the
+		 *	next read. It works with both plain and TLS descriptors.
+		 */
+		class SOCKET_API RecordReader {
+		public:
+			explicit RecordReader(SocketDescriptor& descriptor, std::string delimiter = "\n",
+				std::size_t maxRecordSize = DEFAULT_MAX_RECORD_SIZE);
+			virtual ~RecordReader() = default;
+
+			// non copyable
+			RecordReader(const RecordReader&) = delete;
+			RecordReader& operator=(const RecordReader&) = delete;
+
+			/**
+			 * @brief Reads one complete record.
+			 * @param record The record without its delimiter.
+			 * @return true if a record is read, false if the receive timeout expired or the connection
+			 *	is closed before a delimiter is received.
+			 * @exception this function throws an SocketException if an error occurs or no delimiter
+			 *	is found within the maximum record size.
+			 */
+			NODISCARD bool readRecord(std::string& record);
+
+			/**
+			 * @brief Gets the count of received bytes that are not returned as a record yet.
+			 * @return The count of buffered bytes.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD std::size_t getBufferedSize() const noexcept
+			{
+				return m_end - m_begin;
+			}
+
+			/**
+			 * @brief Finds the first occurrence of a byte with the fastest instruction set of the CPU.
+			 * @param begin Start of the range.
+			 * @param end End of the range.
+			 * @param value The byte to find.
+			 * @return Pointer to the byte, end if it is not found.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD static const char* findByte(const char* begin, const char* end, char value) noexcept;
+
+			static constexpr std::size_t DEFAULT_MAX_RECORD_SIZE = 1024 * 1024;
+
+		private:
+			SocketDescriptor& m_descriptor;
+			std::string m_delimiter;
+			std::size_t m_maxRecordSize;
+			std::vector<char> m_buffer;
+			std::size_t m_begin{};	 // first byte that is not consumed
+			std::size_t m_end{};	 // end of received bytes
+			std::size_t m_scanPos{}; // bytes before it are known not to start a delimiter
+		};
+	}
+}
+
+#endif // RECORD_READER_H
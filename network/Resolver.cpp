@@ -0,0 +1,193 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "Resolver.h"
+#include "SocketException.h"
+
+#include <cstring>
+#include <exception>
+#include <memory>
+
+namespace sdk {
+	namespace network {
+
+		namespace {
+			constexpr const std::size_t MAX_CACHE_ENTRIES = 1024; // expired entries are dropped above this size
+		}
+
+		Resolver::Resolver(std::chrono::seconds positiveTtl /*= std::chrono::seconds{ 60 }*/,
+			std::chrono::seconds negativeTtl /*= std::chrono::seconds{ 5 }*/, std::size_t workerCount /*= 2*/) :
+			m_positiveTtl{ positiveTtl },
+			m_negativeTtl{ negativeTtl }
+		{
+			for (std::size_t index = 0; index < (workerCount > 0 ? workerCount : 1); ++index) {
+				m_workers.emplace_back(&Resolver::workerLoop, this);
+			}
+		}
+
+		Resolver::~Resolver()
+		{
+			{
+				std::lock_guard<std::mutex> lock{ m_mutex };
+				m_stopping = true;
+			}
+			m_condition.notify_all();
+
+			for (auto& worker : m_workers) {
+				worker.join();
+			}
+		}
+
+		std::shared_future<AddressList> Resolver::resolveAsync(const std::string& host, int portNumber,
+			ProtocolType type /*= ProtocolType::tcp*/, IpVersion ipVersion /*= IpVersion::IPv4*/)
+		{
+			const auto service = std::to_string(portNumber);
+			const auto socketType = static_cast<int>(type);
+			const auto family = static_cast<int>(ipVersion);
+
+			//	numeric addresses do not need a lookup
+			AddressList addresses;
+			if (lookup(host, service, socketType, family, AI_NUMERICHOST, addresses) == 0) {
+				std::promise<AddressList> numeric;
+				numeric.set_value(std::move(addresses));
+				return numeric.get_future().share();
+			}
+
+			const auto key = host + '|' + service + '|' + std::to_string(socketType) + '|' + std::to_string(family);
+			const auto now = std::chrono::steady_clock::now();
+
+			std::unique_lock<std::mutex> lock{ m_mutex };
+			const auto found = m_cache.find(key);
+			if (found != m_cache.end() && (found->second.pending || found->second.expiry > now)) {
+				return found->second.result;
+			}
+
+			if (m_cache.size() >= MAX_CACHE_ENTRIES) {
+				removeExpired(now);
+			}
+
+			Request request{ key, host, service, socketType, family, {} };
+			auto result = request.promise.get_future().share();
+			m_cache[key] = Entry{ result, now, true };
+			m_requests.push_back(std::move(request));
+			lock.unlock();
+
+			m_condition.notify_one();
+			return result;
+		}
+
+		void Resolver::clear() noexcept
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			for (auto entry = m_cache.begin(); entry != m_cache.end();) {
+				entry = entry->second.pending ? std::next(entry) : m_cache.erase(entry);
+			}
+		}
+
+		std::size_t Resolver::getCacheSize() const noexcept
+		{
+			std::lock_guard<std::mutex> lock{ m_mutex };
+			return m_cache.size();
+		}
+
+		Resolver& Resolver::defaultResolver()
+		{
+			//	never destroyed, joining the workers at exit may deadlock while a shared library unloads
+			static auto* resolver = new Resolver();
+			return *resolver;
+		}
+
+		void Resolver::workerLoop()
+		{
+			while (true) {
+				std::unique_lock<std::mutex> lock{ m_mutex };
+				m_condition.wait(lock, [this]() { return m_stopping || !m_requests.empty(); });
+				if (m_stopping) {
+					//	the waiting callers are not left hanging
+					for (auto& request : m_requests) {
+						request.promise.set_exception(std::make_exception_ptr(general::SocketException("The resolver is stopped.")));
+					}
+					m_requests.clear();
+					return;
+				}
+
+				auto request = std::move(m_requests.front());
+				m_requests.pop_front();
+				lock.unlock();
+
+				AddressList addresses;
+				const auto ret = lookup(request.host, request.service, request.socketType, request.family, 0, addresses);
+
+				//	the entry is finished before the callers wake up, so they see a settled cache
+				lock.lock();
+				const auto entry = m_cache.find(request.key);
+				if (entry != m_cache.end() && entry->second.pending) {
+					entry->second.pending = false;
+					entry->second.expiry = std::chrono::steady_clock::now() + (ret != 0 ? m_negativeTtl : m_positiveTtl);
+				}
+				lock.unlock();
+
+				if (ret != 0) {
+#ifdef _WIN32
+					request.promise.set_exception(std::make_exception_ptr(general::SocketException(ret)));
+#else
+					request.promise.set_exception(std::make_exception_ptr(general::SocketException(gai_strerror(ret))));
+#endif
+				}
+				else {
+					request.promise.set_value(std::move(addresses));
+				}
+			}
+		}
+
+		void Resolver::removeExpired(std::chrono::steady_clock::time_point now)
+		{
+			for (auto entry = m_cache.begin(); entry != m_cache.end();) {
+				entry = (!entry->second.pending && entry->second.expiry <= now) ? m_cache.erase(entry) : std::next(entry);
+			}
+		}
+
+		int Resolver::lookup(const std::string& host, const std::string& service, int socketType, int family, int flags,
+			AddressList& addresses)
+		{
+			struct addrinfo hints{};
+			struct addrinfo* res = nullptr;
+
+			std::memset(&hints, 0, sizeof(hints));
+			hints.ai_family = family;
+			hints.ai_socktype = socketType;
+			hints.ai_flags = flags;
+
+			const auto ret = getaddrinfo(host.c_str(), service.c_str(), &hints, &res);
+			if (ret != 0) {
+				return ret;
+			}
+
+			const std::unique_ptr<addrinfo, decltype(&freeaddrinfo)> pResPtr{ res, freeaddrinfo };
+
+			for (const auto* ptr = pResPtr.get(); ptr != nullptr; ptr = ptr->ai_next) {
+				addresses.emplace_back(ptr->ai_addr, static_cast<socklen_t>(ptr->ai_addrlen));
+			}
+			return 0;
+		}
+	}
+}
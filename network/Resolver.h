@@ -0,0 +1,148 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef RESOLVER_H
+#define RESOLVER_H
+
+#include "Socket.h"
+#include "PeerAddress.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace sdk {
+	namespace network {
+
+		using AddressList = std::vector<PeerAddress>;
+
+		/**
+		 * @brief Resolver class resolves host names on background threads and caches the results.
+		 * @details Successful lookups are kept for the positive TTL, failures for the negative TTL.
+		 *	Concurrent lookups of the same name share a single getaddrinfo call. Numeric addresses
+		 *	are converted on the calling thread without touching the cache.
+		 */
+		class SOCKET_API Resolver {
+		public:
+			/**
+			 * @brief Creates a resolver.
+			 * @param positiveTtl How long resolved addresses are reused.
+			 * @param negativeTtl How long a failed lookup is reported without asking again.
+			 * @param workerCount Count of threads that call getaddrinfo.
+			 * @exception This function throws std::system_error if a thread cannot be started.
+			 */
+			explicit Resolver(std::chrono::seconds positiveTtl = std::chrono::seconds{ 60 },
+				std::chrono::seconds negativeTtl = std::chrono::seconds{ 5 }, std::size_t workerCount = 2);
+			virtual ~Resolver();
+
+			// non copyable
+			Resolver(const Resolver&) = delete;
+			Resolver& operator=(const Resolver&) = delete;
+
+			/**
+			 * @brief Starts a lookup or joins the cached or running one.
+			 * @param host Host name or numeric address.
+			 * @param portNumber Port number of the addresses.
+			 * @param type Protocol type of the socket that uses the addresses.
+			 * @param ipVersion Address family of the socket that uses the addresses.
+			 * @return The shared result, get() throws an SocketException if the lookup fails.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD std::shared_future<AddressList> resolveAsync(const std::string& host, int portNumber,
+				ProtocolType type = ProtocolType::tcp, IpVersion ipVersion = IpVersion::IPv4);
+
+			/**
+			 * @brief Resolves a host and waits for the result.
+			 * @param host Host name or numeric address.
+			 * @param portNumber Port number of the addresses.
+			 * @param type Protocol type of the socket that uses the addresses.
+			 * @param ipVersion Address family of the socket that uses the addresses.
+			 * @return The addresses of the host.
+			 * @exception this function throws an SocketException if the lookup fails.
+			 */
+			NODISCARD AddressList resolve(const std::string& host, int portNumber,
+				ProtocolType type = ProtocolType::tcp, IpVersion ipVersion = IpVersion::IPv4)
+			{
+				return resolveAsync(host, portNumber, type, ipVersion).get();
+			}
+
+			/**
+			 * @brief Drops every finished lookup from the cache.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void clear() noexcept;
+
+			/**
+			 * @brief Gets the count of cached and running lookups.
+			 * @return The count of lookups.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD std::size_t getCacheSize() const noexcept;
+
+			/**
+			 * @brief Gets the resolver that sockets use to connect.
+			 * @return The shared resolver.
+			 */
+			static Resolver& defaultResolver();
+
+		private:
+			struct Request {
+				std::string key;
+				std::string host;
+				std::string service;
+				int socketType;
+				int family;
+				std::promise<AddressList> promise;
+			};
+
+			struct Entry {
+				std::shared_future<AddressList> result;
+				std::chrono::steady_clock::time_point expiry;
+				bool pending;
+			};
+
+			void workerLoop();
+			void removeExpired(std::chrono::steady_clock::time_point now);
+			// returns the error code of getaddrinfo
+			static int lookup(const std::string& host, const std::string& service, int socketType, int family, int flags,
+				AddressList& addresses);
+
+			std::chrono::seconds m_positiveTtl;
+			std::chrono::seconds m_negativeTtl;
+			mutable std::mutex m_mutex;
+			std::condition_variable m_condition;
+			std::deque<Request> m_requests;
+			std::unordered_map<std::string, Entry> m_cache;
+			std::vector<std::thread> m_workers;
+			bool m_stopping{};
+		};
+	}
+}
+
+#endif // RESOLVER_H
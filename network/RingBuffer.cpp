@@ -0,0 +1,222 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "RingBuffer.h"
+
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
+namespace sdk {
+	namespace network {
+
+		namespace {
+			std::size_t getPageSize() noexcept
+			{
+#ifdef _WIN32
+				SYSTEM_INFO info{};
+				GetSystemInfo(&info);
+				return info.dwPageSize;
+#else
+				const auto pageSize = sysconf(_SC_PAGESIZE);
+				return pageSize > 0 ? static_cast<std::size_t>(pageSize) : 4096;
+#endif
+			}
+
+#ifndef _WIN32
+			int createSharedMemory(const void* owner) noexcept
+			{
+#if defined(__linux__) && defined(MFD_CLOEXEC)
+				(void)owner;
+				return memfd_create("sdk-ring-buffer", MFD_CLOEXEC);
+#else
+				//	the name is unlinked right away, only the descriptor keeps the memory alive
+				char name[64]{};
+				std::snprintf(name, sizeof(name), "/sdk-ring-%ld-%p", static_cast<long>(getpid()), owner);
+				const int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+				if (fd != -1) {
+					shm_unlink(name);
+				}
+				return fd;
+#endif
+			}
+#endif
+		}
+
+		RingBuffer::RingBuffer(std::size_t minCapacity /*= DEFAULT_CAPACITY*/)
+		{
+			m_capacity = getPageSize();
+			while (m_capacity < minCapacity) {
+				//	the doubling would wrap around to zero and never reach the capacity
+				if (m_capacity > (std::numeric_limits<std::size_t>::max)() / 2) {
+					throw std::bad_alloc{};
+				}
+				m_capacity *= 2;
+			}
+
+			mapMirror();
+			if (m_mirrored) {
+				m_mask = m_capacity - 1;
+			}
+			else {
+				m_memory = new char[m_capacity];
+				m_mask = ~static_cast<std::size_t>(0);
+			}
+		}
+
+		RingBuffer::~RingBuffer()
+		{
+			freeMemory();
+		}
+
+		RingBuffer::RingBuffer(RingBuffer&& other) noexcept :
+			m_memory{ other.m_memory },
+			m_capacity{ other.m_capacity },
+			m_mask{ other.m_mask },
+			m_head{ other.m_head },
+			m_tail{ other.m_tail },
+			m_mirrored{ other.m_mirrored }
+		{
+			other.m_memory = nullptr;
+			other.m_capacity = 0;
+			other.m_head = 0;
+			other.m_tail = 0;
+			other.m_mirrored = false;
+		}
+
+		RingBuffer& RingBuffer::operator=(RingBuffer&& other) noexcept
+		{
+			if (this != &other) {
+				freeMemory();
+				m_memory = other.m_memory;
+				m_capacity = other.m_capacity;
+				m_mask = other.m_mask;
+				m_head = other.m_head;
+				m_tail = other.m_tail;
+				m_mirrored = other.m_mirrored;
+
+				other.m_memory = nullptr;
+				other.m_capacity = 0;
+				other.m_head = 0;
+				other.m_tail = 0;
+				other.m_mirrored = false;
+			}
+			return *this;
+		}
+
+		char* RingBuffer::writeData() noexcept
+		{
+			//	without the mirror the free space is made contiguous by moving the data to the front
+			if (!m_mirrored && m_head > 0) {
+				std::memmove(m_memory, m_memory + m_head, size());
+				m_tail -= m_head;
+				m_head = 0;
+			}
+			return m_memory + (m_tail & m_mask);
+		}
+
+		void RingBuffer::commit(std::size_t count) noexcept
+		{
+			const auto freeSize = writableSize();
+			m_tail += count < freeSize ? count : freeSize;
+		}
+
+		void RingBuffer::consume(std::size_t count) noexcept
+		{
+			const auto usedSize = size();
+			if (count >= usedSize) {
+				clear();
+				return;
+			}
+
+			m_head += count;
+			if (m_mirrored && m_head >= m_capacity) {
+				m_head -= m_capacity;
+				m_tail -= m_capacity;
+			}
+		}
+
+		void RingBuffer::mapMirror()
+		{
+#ifndef _WIN32
+			const int fd = createSharedMemory(this);
+			if (fd == -1) {
+				return;
+			}
+
+			if (ftruncate(fd, static_cast<off_t>(m_capacity)) != 0) {
+				close(fd);
+				return;
+			}
+
+			//	reserve twice the capacity, then map the same pages over both halves
+			void* reserved = mmap(nullptr, 2 * m_capacity, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (reserved == MAP_FAILED) {
+				close(fd);
+				return;
+			}
+
+			char* base = static_cast<char*>(reserved);
+			if (mmap(base, m_capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+				mmap(base + m_capacity, m_capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+				munmap(reserved, 2 * m_capacity);
+				close(fd);
+				return;
+			}
+
+			close(fd); // the mappings keep the memory alive
+			m_memory = base;
+			m_mirrored = true;
+#endif
+		}
+
+		void RingBuffer::freeMemory() noexcept
+		{
+			if (m_memory == nullptr) {
+				return;
+			}
+
+#ifndef _WIN32
+			if (m_mirrored) {
+				munmap(m_memory, 2 * m_capacity);
+				m_memory = nullptr;
+				return;
+			}
+#endif
+			delete[] m_memory;
+			m_memory = nullptr;
+		}
+	}
+}
@@ -0,0 +1,149 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include "SocketExport.h"
+
+#include <cstddef>
+
+namespace sdk {
+	namespace network {
+
+		/**
+		 * @brief RingBuffer class is a receive buffer whose memory is mapped twice back to back.
+		 * @details Because the second mapping mirrors the first one, both the readable bytes and
+		 *	the free space are always contiguous, even when they wrap around the end of the buffer.
+		 *	Parsers get a linear view without any copy and a long lived connection reuses the same
+		 *	memory forever. Where the mirror cannot be mapped (Windows or a failing system call) the
+		 *	buffer falls back to a single allocation that is compacted when the free space wraps.
+		 */
+		class SOCKET_API RingBuffer {
+		public:
+			/**
+			 * @brief Creates a ring buffer.
+			 * @param minCapacity Minimum capacity in bytes, it is rounded up to a power of two multiple
+			 *	of the page size.
+			 * @exception This function throws std::bad_alloc if the memory cannot be allocated or the
+			 *	capacity cannot be represented.
+			 */
+			explicit RingBuffer(std::size_t minCapacity = DEFAULT_CAPACITY);
+			virtual ~RingBuffer();
+
+			RingBuffer(RingBuffer&& other) noexcept;
+			RingBuffer& operator=(RingBuffer&& other) noexcept;
+
+			// non copyable
+			RingBuffer(const RingBuffer&) = delete;
+			RingBuffer& operator=(const RingBuffer&) = delete;
+
+			/**
+			 * @brief Gets the readable bytes as one contiguous range of size() bytes.
+			 * @return Pointer to the first readable byte.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD const char* data() const noexcept
+			{
+				return m_memory + (m_head & m_mask);
+			}
+
+			NODISCARD std::size_t size() const noexcept
+			{
+				return m_tail - m_head;
+			}
+
+			NODISCARD bool empty() const noexcept
+			{
+				return m_tail == m_head;
+			}
+
+			NODISCARD std::size_t capacity() const noexcept
+			{
+				return m_capacity;
+			}
+
+			/**
+			 * @brief Checks whether the memory is mirrored or the buffer uses the compacting fallback.
+			 * @return true if the memory is mapped twice.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD bool isMirrored() const noexcept
+			{
+				return m_mirrored;
+			}
+
+			/**
+			 * @brief Gets the free space as one contiguous range of writableSize() bytes.
+			 * @return Pointer to the first free byte.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD char* writeData() noexcept;
+
+			NODISCARD std::size_t writableSize() const noexcept
+			{
+				return m_capacity - size();
+			}
+
+			/**
+			 * @brief Appends the bytes that are written into writeData() to the readable bytes.
+			 * @param count Count of written bytes, it is clamped to writableSize().
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void commit(std::size_t count) noexcept;
+
+			/**
+			 * @brief Drops bytes from the front of the readable bytes.
+			 * @param count Count of processed bytes, it is clamped to size().
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void consume(std::size_t count) noexcept;
+
+			/**
+			 * @brief Drops all readable bytes.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void clear() noexcept
+			{
+				m_head = m_tail = 0;
+			}
+
+			static constexpr std::size_t DEFAULT_CAPACITY = 64 * 1024;
+
+		private:
+			void mapMirror();
+			void freeMemory() noexcept;
+
+			char* m_memory{};
+			std::size_t m_capacity{};
+			std::size_t m_mask{};	 // wraps the offsets of a mirrored buffer, all ones otherwise
+			std::size_t m_head{};	 // offset of the first readable byte
+			std::size_t m_tail{};	 // offset after the last readable byte
+			bool m_mirrored{};
+		};
+	}
+}
+
+#endif // RING_BUFFER_H
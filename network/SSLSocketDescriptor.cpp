@@ -23,17 +23,70 @@
 #include "SSLSocketDescriptor.h"
 #include "SocketException.h"
 #include "SSLSocket.h"
-#include <iterator>
+#include "EventLoop.h"
+#include "Reactor.h"
+#include <algorithm>
+#include <climits>
 
 #if OPENSSL_SUPPORTED
 #include <openssl/x509v3.h> // required for host verification
 #endif						// OPENSSL_SUPPORTED
 
+#include <cstring>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#endif // _WIN32
+
 namespace sdk {
 	namespace network {
 
 #if OPENSSL_SUPPORTED
 
+		namespace {
+			constexpr const std::size_t MAX_RECORD_SIZE = 16384; // maximum plaintext of a TLS record
+			constexpr const int SHUTDOWN_TIMEOUT = 1000;		  // milliseconds
+			constexpr const int WAIT_SLICE = 100;				  // milliseconds, the interrupt callback is checked in between
+
+			// switches a blocking socket to non-blocking mode for a scope, SSL_write on a
+			// blocking socket could otherwise block past the deadline of writeAll().
+			class NonBlockingScope {
+			public:
+				NonBlockingScope(SOCKET socketId, bool enable) noexcept :
+					m_socketId{ socketId }
+				{
+#ifndef _WIN32
+					if (enable) {
+						const int flags = fcntl(m_socketId, F_GETFL, 0);
+						if (flags != -1 && (flags & O_NONBLOCK) == 0 &&
+							fcntl(m_socketId, F_SETFL, flags | O_NONBLOCK) != -1) {
+							m_flags = flags;
+						}
+					}
+#else
+					static_cast<void>(enable);
+#endif // _WIN32
+				}
+
+				~NonBlockingScope()
+				{
+#ifndef _WIN32
+					if (m_flags != -1) {
+						(void)fcntl(m_socketId, F_SETFL, m_flags);
+					}
+#endif // _WIN32
+				}
+
+				// non copyable
+				NonBlockingScope(const NonBlockingScope&) = delete;
+				NonBlockingScope& operator=(const NonBlockingScope&) = delete;
+
+			private:
+				SOCKET m_socketId;
+				int m_flags{ -1 };
+			};
+		}
+
 		/**************************Secure Object Part**************************/
 		SSLSocketDescriptor::SSLSocketDescriptor(SOCKET socketId, const SSLSocket& sSocket) :
 			SocketDescriptor{ socketId, sSocket },
@@ -48,15 +101,27 @@ namespace sdk {
 
 		SSLSocketDescriptor::~SSLSocketDescriptor()
 		{
+			if (m_ssl == nullptr) {
+				return;
+			}
+
+			//	Send our close_notify, a peer that does not read it cannot keep us here
+			//	longer than the shutdown timeout.
+			const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds{ SHUTDOWN_TIMEOUT };
 			int ret = 0;
-			bool bDone = false;
-			while ((ret = SSL_shutdown(m_ssl.get())) <= 0 && !bDone) {
-				switch (const int errCode = SSL_get_error(m_ssl.get(), ret)) {
-				case SSL_ERROR_WANT_READ:
-				case SSL_ERROR_WANT_WRITE:
+			while ((ret = SSL_shutdown(m_ssl.get())) < 0) {
+				const int errCode = SSL_get_error(m_ssl.get(), ret);
+				if (errCode != SSL_ERROR_WANT_READ && errCode != SSL_ERROR_WANT_WRITE) {
 					break;
-				default:
-					bDone = true;
+				}
+
+				const auto waitMs = getWaitSlice(deadline, std::chrono::milliseconds{ SHUTDOWN_TIMEOUT });
+				try {
+					if (waitMs == 0 || waitForRetry(errCode, waitMs) == EVENT_NONE) {
+						break;
+					}
+				}
+				catch (const general::SocketException&) {
 					break;
 				}
 			}
@@ -86,6 +151,7 @@ namespace sdk {
 				case SSL_ERROR_WANT_READ:
 				case SSL_ERROR_WANT_WRITE:
 				case SSL_ERROR_WANT_CONNECT:
+					(void)waitForRetry(errCode, WAIT_SLICE);
 					break;
 				case SSL_ERROR_ZERO_RETURN:
 					SSL_shutdown(m_ssl.get());
@@ -111,7 +177,9 @@ namespace sdk {
 
 				switch (const int errCode = SSL_get_error(m_ssl.get(), retCode)) {
 				case SSL_ERROR_WANT_READ:
+				case SSL_ERROR_WANT_WRITE:
 				case SSL_ERROR_WANT_ACCEPT:
+					(void)waitForRetry(errCode, WAIT_SLICE);
 					break;
 				case SSL_ERROR_ZERO_RETURN:
 					SSL_shutdown(m_ssl.get());
@@ -123,6 +191,11 @@ namespace sdk {
 				}
 			}
 
+			verifyPeer();
+		}
+
+		void SSLSocketDescriptor::verifyPeer() const
+		{
 			const X509_unique_ptr peer{ SSL_get_peer_certificate(m_ssl.get()), X509_free };
 			if (peer) {
 				const long retCode = SSL_get_verify_result(m_ssl.get());
@@ -145,6 +218,14 @@ namespace sdk {
 			}
 		}
 
+		std::uint32_t SSLSocketDescriptor::waitForRetry(int errCode, int timeoutMs) const
+		{
+			const std::uint32_t events = (errCode == SSL_ERROR_WANT_WRITE || errCode == SSL_ERROR_WANT_CONNECT) ?
+											 EVENT_WRITE :
+											 EVENT_READ;
+			return Reactor::waitFor(m_socketId, events, timeoutMs, m_socketRef.getCancellationToken());
+		}
+
 		std::size_t SSLSocketDescriptor::read(char& msgByte) const
 		{
 			const int numBytes = SSL_read(m_ssl.get(), &msgByte, 1);
@@ -154,19 +235,22 @@ namespace sdk {
 			return static_cast<std::size_t>(numBytes);
 		}
 
-		std::string SSLSocketDescriptor::read(int maxSize /*= 0*/) const
+		bool SSLSocketDescriptor::waitReadable(int timeoutMs) const
 		{
-			const int bufLen = (maxSize > 0 && maxSize < MAX_MESSAGE_SIZE) ? maxSize : MAX_MESSAGE_SIZE - 1;
-
-			std::string strMessage;
-			std::vector<char> dataVec(bufLen);
+			return SSL_pending(m_ssl.get()) > 0 || SocketDescriptor::waitReadable(timeoutMs);
+		}
 
-			int receiveByte = 0;
+		std::size_t SSLSocketDescriptor::readAvailable(char* buffer, std::size_t bufSize, int timeoutMs) const
+		{
+			std::size_t totalBytes = 0;
 
 			const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
 
-			while (true) {
-				while ((receiveByte = SSL_read(m_ssl.get(), dataVec.data(), bufLen)) == -1) {
+			while (totalBytes < bufSize) {
+				const auto bufLen = static_cast<int>((std::min)(bufSize - totalBytes, static_cast<std::size_t>(INT_MAX)));
+
+				int receiveByte = 0;
+				while ((receiveByte = SSL_read(m_ssl.get(), buffer + totalBytes, bufLen)) == -1) {
 					if (callbackInterrupt &&
 						callbackInterrupt(m_socketRef)) {
 						throw general::SSLSocketException(INTERRUPT_MSG);
@@ -174,6 +258,10 @@ namespace sdk {
 
 					switch (const auto errCode = SSL_get_error(m_ssl.get(), receiveByte)) {
 					case SSL_ERROR_WANT_READ:
+					case SSL_ERROR_WANT_WRITE: // renegotiation
+						if (waitForRetry(errCode, timeoutMs) == EVENT_NONE) {
+							return totalBytes;
+						}
 						break;
 					case SSL_ERROR_ZERO_RETURN:
 						SSL_shutdown(m_ssl.get());
@@ -185,11 +273,12 @@ namespace sdk {
 					}
 				}
 
-				if (receiveByte > 0) {
-					std::move(dataVec.begin(), dataVec.begin() + receiveByte,
-						std::back_inserter(strMessage));
+				if (receiveByte <= 0) {
+					break;
 				}
 
+				totalBytes += static_cast<std::size_t>(receiveByte);
+
 				if (SSL_pending(m_ssl.get()) == 0) {
 					break;
 				}
@@ -198,30 +287,9 @@ namespace sdk {
 					callbackInterrupt(m_socketRef)) {
 					throw general::SSLSocketException(INTERRUPT_MSG);
 				}
-
-				if (maxSize > 0 && strMessage.size() >= (std::size_t)maxSize) {
-					break;
-				}
-
-				if (receiveByte <= 0) {
-					break;
-				}
 			}
 
-			return strMessage;
-		}
-
-		std::size_t SSLSocketDescriptor::read(std::vector<unsigned char>& message, int maxSize /*= 0*/) const
-		{
-			const auto receivedStr = read(maxSize);
-			std::move(receivedStr.begin(), receivedStr.end(), std::back_inserter(message));
-			return message.size();
-		}
-
-		std::size_t SSLSocketDescriptor::read(std::string& message, int maxSize /*= 0*/) const
-		{
-			message = read(maxSize);
-			return message.size();
+			return totalBytes;
 		}
 
 		int SSLSocketDescriptor::write(std::initializer_list<char> dataList)
@@ -242,6 +310,8 @@ namespace sdk {
 
 				switch (const auto errCode = SSL_get_error(m_ssl.get(), sendBytes)) {
 				case SSL_ERROR_WANT_WRITE:
+				case SSL_ERROR_WANT_READ: // renegotiation
+					(void)waitForRetry(errCode, WAIT_SLICE);
 					break;
 				case SSL_ERROR_ZERO_RETURN:
 					SSL_shutdown(m_ssl.get());
@@ -255,10 +325,125 @@ namespace sdk {
 			return sendBytes;
 		}
 
+		std::size_t SSLSocketDescriptor::writeAll(const char* data, std::size_t dataSize,
+			std::chrono::milliseconds timeout /*= std::chrono::milliseconds{ -1 }*/)
+		{
+			const auto deadline = std::chrono::steady_clock::now() + timeout;
+			std::size_t totalBytes = 0;
+
+			const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
+			const NonBlockingScope nonBlocking{ m_socketId, timeout.count() >= 0 };
+
+			while (totalBytes < dataSize) {
+				// a retried SSL_write must be called with the same arguments. SSL_write reports
+				// nothing until the whole buffer is sent, so a record at a time keeps the count exact.
+				const auto bufLen = static_cast<int>((std::min)(dataSize - totalBytes, MAX_RECORD_SIZE));
+				const int sendBytes = SSL_write(m_ssl.get(), data + totalBytes, bufLen);
+				if (sendBytes > 0) {
+					totalBytes += static_cast<std::size_t>(sendBytes);
+					continue;
+				}
+
+				if (callbackInterrupt &&
+					callbackInterrupt(m_socketRef)) {
+					throw general::SSLSocketException(INTERRUPT_MSG);
+				}
+
+				std::uint32_t waitEvents = EVENT_NONE;
+				switch (const auto errCode = SSL_get_error(m_ssl.get(), sendBytes)) {
+				case SSL_ERROR_WANT_WRITE:
+					waitEvents = EVENT_WRITE;
+					break;
+				case SSL_ERROR_WANT_READ: // renegotiation
+					waitEvents = EVENT_READ;
+					break;
+				case SSL_ERROR_ZERO_RETURN:
+					SSL_shutdown(m_ssl.get());
+#if (__cplusplus >= 201703L)
+					[[fallthrough]];
+#endif
+				default:
+					throw general::SSLSocketException(errCode);
+				}
+
+				const auto waitMs = getWaitSlice(deadline, timeout);
+				if (waitMs == 0) {
+					break; // the deadline expired, the caller gets the partial progress
+				}
+				(void)Reactor::waitFor(m_socketId, waitEvents, waitMs, m_socketRef.getCancellationToken());
+			}
+
+			return totalBytes;
+		}
+
+		std::size_t SSLSocketDescriptor::gatherWrite(const ConstBuffer* buffers, std::size_t count)
+		{
+			char record[MAX_RECORD_SIZE];
+			std::size_t recordSize = 0;
+			std::size_t totalBytes = 0;
+
+			const auto flushRecord = [&]() {
+				if (recordSize > 0) {
+					totalBytes += static_cast<std::size_t>(write(record, static_cast<int>(recordSize)));
+					recordSize = 0;
+				}
+			};
+
+			for (std::size_t i = 0; i < count; ++i) {
+				const char* data = buffers[i].data;
+				std::size_t dataSize = buffers[i].size;
+
+				// a buffer that fills whole records is written in place
+				if (recordSize == 0 && dataSize >= MAX_RECORD_SIZE) {
+					const auto directSize = (std::min)(dataSize, static_cast<std::size_t>(INT_MAX));
+					totalBytes += static_cast<std::size_t>(write(data, static_cast<int>(directSize)));
+					data += directSize;
+					dataSize -= directSize;
+				}
+
+				while (dataSize > 0) {
+					const auto copySize = (std::min)(dataSize, MAX_RECORD_SIZE - recordSize);
+					std::memcpy(record + recordSize, data, copySize);
+					recordSize += copySize;
+					data += copySize;
+					dataSize -= copySize;
+					if (recordSize == MAX_RECORD_SIZE) {
+						flushRecord();
+					}
+				}
+			}
+
+			flushRecord();
+			return totalBytes;
+		}
+
+		std::size_t SSLSocketDescriptor::scatterRead(const MutableBuffer* buffers, std::size_t count) const
+		{
+			std::size_t totalBytes = 0;
+			for (std::size_t i = 0; i < count; ++i) {
+				// only the first buffer waits for data, the next ones take the pending records
+				const auto receiveByte = readAvailable(buffers[i].data, buffers[i].size, i == 0 ? getRecvTimeoutMs() : 0);
+				totalBytes += receiveByte;
+				if (receiveByte < buffers[i].size || SSL_pending(m_ssl.get()) == 0) {
+					break;
+				}
+			}
+			return totalBytes;
+		}
+
+		std::size_t SSLSocketDescriptor::sendFile(int fileFd, std::int64_t& offset, std::size_t length)
+		{
+			return sendFileChunked(fileFd, offset, length);
+		}
+
+		std::size_t SSLSocketDescriptor::writeZeroCopy(const char* data, std::size_t dataSize, std::uint32_t& sequence)
+		{
+			return writeCopied(data, dataSize, sequence);
+		}
+
 		int SSLSocketDescriptor::write(const std::vector<unsigned char>& message)
 		{
-			const std::string strBuf{ message.begin(), message.end() };
-			return write(strBuf.c_str(), static_cast<int>(strBuf.size()));
+			return write(reinterpret_cast<const char*>(message.data()), static_cast<int>(message.size()));
 		}
 
 		int SSLSocketDescriptor::write(const std::string& message)
@@ -266,6 +451,118 @@ namespace sdk {
 			return write(message.c_str(),
 				static_cast<int>(message.size()));
 		}
+#if SOCKET_COROUTINES_SUPPORTED
+		Task<void> SSLSocketDescriptor::asyncConnect(EventLoop& loop)
+		{
+			int retCode{};
+			while ((retCode = SSL_connect(m_ssl.get())) != 1) {
+				switch (const int errCode = SSL_get_error(m_ssl.get(), retCode)) {
+				case SSL_ERROR_WANT_READ:
+					co_await loop.waitFor(m_socketId, EVENT_READ);
+					break;
+				case SSL_ERROR_WANT_WRITE:
+				case SSL_ERROR_WANT_CONNECT:
+					co_await loop.waitFor(m_socketId, EVENT_WRITE);
+					break;
+				case SSL_ERROR_ZERO_RETURN:
+					SSL_shutdown(m_ssl.get());
+					[[fallthrough]];
+				default:
+					throw general::SSLSocketException(errCode);
+				}
+			}
+		}
+
+		Task<void> SSLSocketDescriptor::asyncAccept(EventLoop& loop)
+		{
+			int retCode{};
+			while ((retCode = SSL_accept(m_ssl.get())) != 1) {
+				switch (const int errCode = SSL_get_error(m_ssl.get(), retCode)) {
+				case SSL_ERROR_WANT_READ:
+				case SSL_ERROR_WANT_ACCEPT:
+					co_await loop.waitFor(m_socketId, EVENT_READ);
+					break;
+				case SSL_ERROR_WANT_WRITE:
+					co_await loop.waitFor(m_socketId, EVENT_WRITE);
+					break;
+				case SSL_ERROR_ZERO_RETURN:
+					SSL_shutdown(m_ssl.get());
+					[[fallthrough]];
+				default:
+					throw general::SSLSocketException(errCode);
+				}
+			}
+
+			verifyPeer();
+		}
+
+		Task<std::size_t> SSLSocketDescriptor::asyncRead(EventLoop& loop, char* buffer, std::size_t bufSize)
+		{
+			const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
+
+			while (true) {
+				const int receiveByte = SSL_read(m_ssl.get(), buffer, static_cast<int>(bufSize));
+				if (receiveByte > 0) {
+					co_return static_cast<std::size_t>(receiveByte);
+				}
+
+				if (callbackInterrupt &&
+					callbackInterrupt(m_socketRef)) {
+					throw general::SSLSocketException(INTERRUPT_MSG);
+				}
+
+				switch (const auto errCode = SSL_get_error(m_ssl.get(), receiveByte)) {
+				case SSL_ERROR_WANT_READ:
+					co_await loop.waitFor(m_socketId, EVENT_READ);
+					break;
+				case SSL_ERROR_WANT_WRITE: // renegotiation
+					co_await loop.waitFor(m_socketId, EVENT_WRITE);
+					break;
+				case SSL_ERROR_ZERO_RETURN:
+					SSL_shutdown(m_ssl.get());
+					co_return 0;
+				default:
+					throw general::SSLSocketException(errCode);
+				}
+			}
+		}
+
+		Task<std::size_t> SSLSocketDescriptor::asyncWrite(EventLoop& loop, const char* data, std::size_t dataSize)
+		{
+			const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
+
+			std::size_t totalBytes = 0;
+			while (totalBytes < dataSize) {
+				// a retried SSL_write must be called with the same arguments.
+				const int sendBytes = SSL_write(m_ssl.get(), data + totalBytes, static_cast<int>(dataSize - totalBytes));
+				if (sendBytes > 0) {
+					totalBytes += static_cast<std::size_t>(sendBytes);
+					continue;
+				}
+
+				if (callbackInterrupt &&
+					callbackInterrupt(m_socketRef)) {
+					throw general::SSLSocketException(INTERRUPT_MSG);
+				}
+
+				switch (const auto errCode = SSL_get_error(m_ssl.get(), sendBytes)) {
+				case SSL_ERROR_WANT_WRITE:
+					co_await loop.waitFor(m_socketId, EVENT_WRITE);
+					break;
+				case SSL_ERROR_WANT_READ: // renegotiation
+					co_await loop.waitFor(m_socketId, EVENT_READ);
+					break;
+				case SSL_ERROR_ZERO_RETURN:
+					SSL_shutdown(m_ssl.get());
+					[[fallthrough]];
+				default:
+					throw general::SSLSocketException(errCode);
+				}
+			}
+
+			co_return totalBytes;
+		}
+#endif // SOCKET_COROUTINES_SUPPORTED
 #endif // OPENSSL_SUPPORTED
 	}
 }
\ No newline at end of file
@@ -65,6 +65,12 @@ namespace sdk {
 			 */
 			void connect();
 
+			// the read overloads of the base class end up in readAvailable()
+			using SocketDescriptor::read;
+
+			// the deadline overload of the base class ends up in writeAll() with a timeout
+			using SocketDescriptor::writeAll;
+
 			/**
 			 * @brief This method used for reading operations from related secure socket layer.
 			 * @param msgByte One byte character to read.
@@ -72,22 +78,6 @@ namespace sdk {
 			 * @exception This method throws an SSLSocketException if an error occurs.
 			 */
 			NODISCARD std::size_t read(char& msgByte) const override;
-			/**
-			 * @brief This method used for reading operations from related secure socket layer.
-			 * @param message String.
-			 * @param maxSize Max read size.
-			 * @return Return byte count that read.
-			 * @exception This method throws an SSLSocketException if an error occurs.
-			 */
-			NODISCARD std::size_t read(std::vector<unsigned char>& message, int maxSize = 0) const override;
-			/**
-			 * @brief This method used for reading operations from related secure socket layer.
-			 * @param message String.
-			 * @param maxSize Max read size.
-			 * @return Return byte count that read.
-			 * @exception This method throws an SSLSocketException if an error occurs.
-			 */
-			NODISCARD std::size_t read(std::string& message, int maxSize = 0) const override;
 
 			/**
 			 * @brief This method used for writing operations from related secure socket layer.
@@ -122,6 +112,62 @@ namespace sdk {
 			 */
 			NODISCARD int write(const std::string& message) override;
 
+			/**
+			 * @brief This method writes the whole message. It waits in the direction that openssl
+			 * asks for and resumes until the message is sent or the timeout expires.
+			 * @param data Bytes of message.
+			 * @param dataSize Size of message.
+			 * @param timeout Maximum time to spend, a negative value waits until the message is sent.
+			 * A blocking socket is switched to non-blocking mode while a timeout is in effect; on Windows
+			 * the mode cannot be queried, so SSL_write on a blocking socket can block past the timeout.
+			 * @return Return byte count that write, less than dataSize if the timeout expired. A record that
+			 * the timeout interrupted is not counted, the next write has to start with the same bytes.
+			 * @exception This method throws an SSLSocketException if an error occurs.
+			 */
+			NODISCARD std::size_t writeAll(const char* data, std::size_t dataSize,
+				std::chrono::milliseconds timeout = std::chrono::milliseconds{ -1 }) override;
+
+			/**
+			 * @brief This method coalesces the buffers into as few TLS records as possible,
+			 * so a small header, body and trailer are sent as a single record.
+			 * @param buffers Array of buffers, they are written in order.
+			 * @param count Count of buffers.
+			 * @return Return byte count that write.
+			 * @exception This method throws an SSLSocketException if an error occurs.
+			 */
+			NODISCARD std::size_t gatherWrite(const ConstBuffer* buffers, std::size_t count) override;
+
+			/**
+			 * @brief This method fills the buffers in order with decrypted bytes.
+			 * @param buffers Array of buffers.
+			 * @param count Count of buffers.
+			 * @return Return byte count that read.
+			 * @exception This method throws an SSLSocketException if an error occurs.
+			 */
+			NODISCARD std::size_t scatterRead(const MutableBuffer* buffers, std::size_t count) const override;
+
+			/**
+			 * @brief This method sends a part of a file in chunks, since the file data has to be
+			 * encrypted in user space.
+			 * @param fileFd Descriptor of the file opened for reading.
+			 * @param offset File offset to start from, it is advanced by the byte count that sent.
+			 * @param length Byte count to send.
+			 * @return Return byte count that sent.
+			 * @exception This method throws an SSLSocketException if an error occurs.
+			 */
+			NODISCARD std::size_t sendFile(int fileFd, std::int64_t& offset, std::size_t length) override;
+
+			/**
+			 * @brief This method copies the data since it has to be encrypted in user space,
+			 * the send is reported as completed immediately.
+			 * @param data Bytes of message.
+			 * @param dataSize Size of message.
+			 * @param sequence Sequence number of the send.
+			 * @return Return byte count that write.
+			 * @exception This method throws an SSLSocketException if an error occurs.
+			 */
+			NODISCARD std::size_t writeZeroCopy(const char* data, std::size_t dataSize, std::uint32_t& sequence) override;
+
 			/**
 			 * @brief This method used for accepting operations from related secure socket layer.
 			 * @return nothing.
@@ -129,10 +175,77 @@ namespace sdk {
 			 */
 			void accept();
 
+#if SOCKET_COROUTINES_SUPPORTED
+			/**
+			 * @brief Performs the client side handshake without blocking the thread. The coroutine is
+			 * suspended on the loop in the direction that openssl asks for.
+			 * @param loop The event loop that resumes the coroutine.
+			 * @return A task that completes when the handshake is done.
+			 * @exception the task throws an SSLSocketException if an error occurs.
+			 */
+			NODISCARD Task<void> asyncConnect(EventLoop& loop);
+
+			/**
+			 * @brief Performs the server side handshake and verifies the peer certificate without
+			 * blocking the thread.
+			 * @param loop The event loop that resumes the coroutine.
+			 * @return A task that completes when the handshake is done.
+			 * @exception the task throws an SSLSocketException if an error occurs.
+			 */
+			NODISCARD Task<void> asyncAccept(EventLoop& loop);
+
+			/**
+			 * @brief Reads decrypted bytes from related secure socket layer.
+			 * @param loop The event loop that resumes the coroutine.
+			 * @param buffer Destination buffer.
+			 * @param bufSize Size of destination buffer.
+			 * @return A task that yields the byte count that read, 0 if the peer closed the connection.
+			 * @exception the task throws an SSLSocketException if an error occurs.
+			 */
+			NODISCARD Task<std::size_t> asyncRead(EventLoop& loop, char* buffer, std::size_t bufSize);
+
+			/**
+			 * @brief Writes all bytes to related secure socket layer.
+			 * @param loop The event loop that resumes the coroutine.
+			 * @param data Bytes of message.
+			 * @param dataSize Size of message.
+			 * @return A task that yields the byte count that write.
+			 * @exception the task throws an SSLSocketException if an error occurs.
+			 */
+			NODISCARD Task<std::size_t> asyncWrite(EventLoop& loop, const char* data, std::size_t dataSize);
+#endif // SOCKET_COROUTINES_SUPPORTED
+
 		protected:
-			std::string read(int maxSize = 0) const override;
+			/**
+			 * @brief Decrypts into the buffer until it is full or no more record is pending.
+			 * @param buffer Destination buffer.
+			 * @param bufSize Size of destination buffer.
+			 * @param timeoutMs Wait timeout for the first bytes in milliseconds.
+			 * @return Return byte count that read.
+			 * @exception This method throws an SSLSocketException if an error occurs.
+			 */
+			NODISCARD std::size_t readAvailable(char* buffer, std::size_t bufSize, int timeoutMs) const override;
+
+			/**
+			 * @brief Waits until data can be read, the records that openssl already decrypted count as data.
+			 * @param timeoutMs Wait timeout in milliseconds.
+			 * @return true if data or an error is pending, false if the timeout expired.
+			 * @exception This method throws an SocketException if an error occurs.
+			 */
+			NODISCARD bool waitReadable(int timeoutMs) const override;
 
 		private:
+			void verifyPeer() const;
+
+			/**
+			 * @brief Waits until the socket is ready in the direction that openssl asks for.
+			 * @param errCode SSL_ERROR_WANT_READ, SSL_ERROR_WANT_WRITE, SSL_ERROR_WANT_CONNECT or SSL_ERROR_WANT_ACCEPT.
+			 * @param timeoutMs Wait timeout in milliseconds.
+			 * @return The ready events, EVENT_NONE if the timeout expired.
+			 * @exception This method throws an SocketException if an error occurs.
+			 */
+			NODISCARD std::uint32_t waitForRetry(int errCode, int timeoutMs) const;
+
 			std::string m_hostname;
 			SSL_unique_ptr m_ssl;
 		};
@@ -22,12 +22,117 @@
 
 #include "Socket.h"
 #include "SocketException.h"
+#include "Reactor.h"
+#include "IoUring.h"
+#include "EventLoop.h"
+#include "Resolver.h"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
 #include <cstring>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <netinet/tcp.h>
+#endif
 
 namespace sdk {
 
 	namespace {
-		constexpr auto const DEFAULT_TIMEOUT = 1000L;
+		constexpr auto const DEFAULT_TIMEOUT = 1; // milliseconds
+		constexpr auto const CONNECTION_ATTEMPT_DELAY = std::chrono::milliseconds{ 250 }; // RFC 8305 recommended value
+		constexpr auto const RACE_WAIT_SLICE = 100; // milliseconds, the interrupt callback is checked in between
+
+		// options that a racing attempt takes over from the socket it replaces, the ones that SocketOption
+		// sets on a connecting socket and the buffer sizes
+		struct InheritedOption {
+			int level;
+			int name;
+		};
+
+		constexpr const InheritedOption INHERITED_OPTIONS[] = {
+			{ SOL_SOCKET, SO_DEBUG },
+			{ SOL_SOCKET, SO_REUSEADDR },
+#ifdef SO_REUSEPORT
+			{ SOL_SOCKET, SO_REUSEPORT },
+#endif
+#ifdef SO_ZEROCOPY
+			{ SOL_SOCKET, SO_ZEROCOPY },
+#endif
+			{ SOL_SOCKET, SO_KEEPALIVE },
+			{ SOL_SOCKET, SO_LINGER },
+			{ SOL_SOCKET, SO_RCVTIMEO },
+			{ SOL_SOCKET, SO_SNDTIMEO },
+			{ SOL_SOCKET, SO_RCVBUF },
+			{ SOL_SOCKET, SO_SNDBUF },
+			{ IPPROTO_TCP, TCP_NODELAY }
+		};
+
+		void copySocketOptions(SOCKET source, SOCKET target) noexcept
+		{
+			for (const auto& option : INHERITED_OPTIONS) {
+				char value[32]{};
+				socklen_t valueSize = sizeof(value);
+				if (getsockopt(source, option.level, option.name, value, &valueSize) != 0) {
+					continue;
+				}
+
+				//	An option at its default is not set, a buffer size that is set turns off the autotuning of Linux.
+				char targetValue[32]{};
+				socklen_t targetSize = sizeof(targetValue);
+				if (getsockopt(target, option.level, option.name, targetValue, &targetSize) == 0 &&
+					targetSize == valueSize && std::memcmp(value, targetValue, static_cast<std::size_t>(valueSize)) == 0) {
+					continue;
+				}
+
+#ifdef __linux__
+				if (option.level == SOL_SOCKET && (option.name == SO_RCVBUF || option.name == SO_SNDBUF) &&
+					valueSize == sizeof(int)) {
+					// Linux reports the doubled size that it reserves for the requested one
+					int bufferSize{};
+					std::memcpy(&bufferSize, value, sizeof(bufferSize));
+					bufferSize /= 2;
+					std::memcpy(value, &bufferSize, sizeof(bufferSize));
+				}
+#endif
+				(void)setsockopt(target, option.level, option.name, value, valueSize);
+			}
+		}
+
+		// a bound socket has a local port, an unbound one reports port 0
+		bool isBound(SOCKET socketId) noexcept
+		{
+			sockaddr_storage address{};
+			socklen_t addressSize = sizeof(address);
+			if (getsockname(socketId, reinterpret_cast<sockaddr*>(&address), &addressSize) == SOCKET_ERROR) {
+				return false;
+			}
+
+			if (address.ss_family == AF_INET6) {
+				return reinterpret_cast<const sockaddr_in6*>(&address)->sin6_port != 0;
+			}
+			return address.ss_family == AF_INET && reinterpret_cast<const sockaddr_in*>(&address)->sin_port != 0;
+		}
+
+		// errors of a single pending connection, the next one may still be accepted
+		bool isAbortedConnection(int errorCode) noexcept
+		{
+#ifdef _WIN32
+			return errorCode == WSAECONNRESET;
+#else
+			return errorCode == ECONNABORTED || errorCode == EINTR || errorCode == EPROTO;
+#endif
+		}
+
+		void closeSocket(SOCKET socketId) noexcept
+		{
+			while (closesocket(socketId) == SOCKET_ERROR) {
+				if (WSAGetLastError() != WSAEWOULDBLOCK) {
+					break;
+				}
+			}
+		}
 	}
 
 	namespace network {
@@ -84,6 +189,11 @@ namespace sdk {
 
 		Socket::~Socket()
 		{
+#if IO_URING_SUPPORTED
+			if (m_ioEngine == IoEngine::ioUring) {
+				IoUring::cancelAccept(m_socketId);
+			}
+#endif
 			if (m_socketId != INVALID_SOCKET) {
 				shutdown(m_socketId, SD_BOTH);
 				while (closesocket(m_socketId) == SOCKET_ERROR) {
@@ -97,49 +207,30 @@ namespace sdk {
 
 		void Socket::fillAddrInfo()
 		{
-			struct addrinfo hints{};
-			struct addrinfo* res = nullptr;
-			struct addrinfo* ptr = nullptr;
-
-			std::memset(&hints, 0, sizeof(hints));
-			hints.ai_family = AF_UNSPEC; // AF_INET or AF_INET6 to force version
-			hints.ai_socktype = SOCK_STREAM;
-			// hints.ai_flags = AI_NUMERICHOST;
-
-			const auto ret = getaddrinfo(m_ipAddress.c_str(), std::to_string(m_portNumber).c_str(), &hints, &res);
-			if (ret != 0) {
-#ifdef _WIN32
-				throw general::SocketException(WSAGetLastError());
-#else
-				// gai_strerror is not thread-safe.
-				throw general::SocketException(gai_strerror(ret));
-#endif
-			}
+			//	the lookup is cached and shared with concurrent connects to the same host
+			const auto addresses = Resolver::defaultResolver().resolve(m_ipAddress, m_portNumber, m_protocolType, m_ipVersion);
 
-			const std::unique_ptr<addrinfo, decltype(&freeaddrinfo)> pResPtr{ res, freeaddrinfo };
-
-			for (ptr = pResPtr.get(); ptr != nullptr; ptr = ptr->ai_next) {
-				// get the pointer to the address itself,
-				// different fields in IPv4 and IPv6:
-				if (ptr->ai_family == AF_INET) { // IPv4
-					const auto* ipv4 = reinterpret_cast<struct sockaddr_in*>(ptr->ai_addr);
-					std::memcpy(&m_sockAddressIpv4.sin_addr, &ipv4->sin_addr, ptr->ai_addrlen);
+			for (const auto& address : addresses) {
+				if (m_ipVersion == IpVersion::IPv4 && address.data()->sa_family == AF_INET) {
+					std::memcpy(&m_sockAddressIpv4, address.data(), sizeof(m_sockAddressIpv4));
+					return;
 				}
-				else { // IPv6
-					const auto* ipv6 = reinterpret_cast<struct sockaddr_in6*>(ptr->ai_addr);
-					std::memcpy(&m_sockAddressIpv6.sin6_addr, &ipv6->sin6_addr, ptr->ai_addrlen);
+				if (m_ipVersion == IpVersion::IPv6 && address.data()->sa_family == AF_INET6) {
+					std::memcpy(&m_sockAddressIpv6, address.data(), sizeof(m_sockAddressIpv6));
+					return;
 				}
 			}
+
+			throw general::SocketException("No address is found for " + m_ipAddress);
 		}
 
 		void Socket::connect()
 		{
-#ifdef _WIN32
-			constexpr struct timeval timeout{ 0, DEFAULT_TIMEOUT };
-#else
-			struct timeval timeout{ 0, DEFAULT_TIMEOUT };
-#endif
-			int err{};
+			//	the attempts use new sockets, a local address bound by the caller would be lost
+			if (m_happyEyeballs && m_protocolType == ProtocolType::tcp && !isBound(m_socketId)) {
+				connectHappyEyeballs();
+				return;
+			}
 
 			fillAddrInfo();
 
@@ -147,6 +238,28 @@ namespace sdk {
 
 			const auto* stAddress = (m_ipVersion == IpVersion::IPv4 ? reinterpret_cast<const sockaddr*>(&m_sockAddressIpv4) : reinterpret_cast<const sockaddr*>(&m_sockAddressIpv6));
 
+#if IO_URING_SUPPORTED
+			if (m_ioEngine == IoEngine::ioUring) {
+				//	check if any interrupt happened by user
+				if (m_callbackInterrupt && m_callbackInterrupt(*this)) {
+					throw general::SocketException(INTERRUPT_MSG);
+				}
+
+				// the ring waits until the connection completes.
+				if (IoUring::threadInstance().connect(m_socketId, stAddress, addressSize, m_cancelToken.get()) == SOCKET_ERROR) {
+					if (m_cancelToken && m_cancelToken->isCancelled()) {
+						throw general::SocketException(CANCEL_MSG);
+					}
+
+					const int lastError = WSAGetLastError();
+					if (lastError != WSAEISCONN) {
+						throw general::SocketException(lastError);
+					}
+				}
+				return;
+			}
+#endif
+
 			while (::connect(m_socketId, stAddress, addressSize) == SOCKET_ERROR) {
 				//	check if any interrupt happened by user
 				if (m_callbackInterrupt && m_callbackInterrupt(*this)) {
@@ -156,26 +269,16 @@ namespace sdk {
 				switch (const int lastError = WSAGetLastError()) {
 				case WSAEINPROGRESS:
 				case WSAEWOULDBLOCK: {
-					fd_set writeFds{};
-					fd_set exceptFds{};
-
 					while (true) {
 						if (m_callbackInterrupt && m_callbackInterrupt(*this)) {
 							throw general::SocketException(INTERRUPT_MSG);
 						}
 
-						FD_ZERO(&writeFds);
-						FD_SET(m_socketId, &writeFds);
-						FD_ZERO(&exceptFds);
-						FD_SET(m_socketId, &exceptFds);
-						err = select(static_cast<int>(m_socketId) + 1, nullptr, &writeFds, &exceptFds, &timeout);
-						if (err < 0) {
-							throw general::SocketException(WSAGetLastError());
-						}
-						if (FD_ISSET(m_socketId, &exceptFds)) {
+						const auto events = Reactor::waitFor(m_socketId, EVENT_WRITE, m_callbackInterrupt ? DEFAULT_TIMEOUT : -1, m_cancelToken.get());
+						if ((events & EVENT_ERROR) != 0) {
 							throw general::SocketException("Cannot connect to the server");
 						}
-						if (FD_ISSET(m_socketId, &writeFds)) {
+						if ((events & EVENT_WRITE) != 0) {
 							break;
 						}
 					}
@@ -190,6 +293,186 @@ namespace sdk {
 			}
 		}
 
+		void Socket::connectHappyEyeballs()
+		{
+			//	both families are resolved at the same time, a failure of one of them is tolerated
+			auto& resolver = Resolver::defaultResolver();
+			auto ipv6Lookup = resolver.resolveAsync(m_ipAddress, m_portNumber, m_protocolType, IpVersion::IPv6);
+			auto ipv4Lookup = resolver.resolveAsync(m_ipAddress, m_portNumber, m_protocolType, IpVersion::IPv4);
+
+			AddressList ipv6Addresses;
+			AddressList ipv4Addresses;
+			try {
+				ipv6Addresses = ipv6Lookup.get();
+			}
+			catch (const general::SocketException&) {
+				// the host may have IPv4 addresses only
+			}
+			try {
+				ipv4Addresses = ipv4Lookup.get();
+			}
+			catch (const general::SocketException&) {
+				if (ipv6Addresses.empty()) {
+					throw;
+				}
+			}
+
+			//	the families alternate, starting with IPv6
+			AddressList candidates;
+			for (std::size_t index = 0; index < (std::max)(ipv6Addresses.size(), ipv4Addresses.size()); ++index) {
+				if (index < ipv6Addresses.size()) {
+					candidates.push_back(ipv6Addresses[index]);
+				}
+				if (index < ipv4Addresses.size()) {
+					candidates.push_back(ipv4Addresses[index]);
+				}
+			}
+
+			struct Attempt {
+				SOCKET socketId;
+				std::size_t candidate;
+			};
+
+			std::vector<Attempt> attempts;
+			std::vector<SOCKET> readySockets;
+			Reactor reactor;
+			const auto closeAttempts = [&attempts, &reactor](SOCKET keepSocket) {
+				for (const auto& attempt : attempts) {
+					reactor.remove(attempt.socketId);
+					if (attempt.socketId != keepSocket) {
+						closeSocket(attempt.socketId);
+					}
+				}
+				attempts.clear();
+			};
+
+			int lastError = 0;
+			std::size_t nextCandidate = 0;
+			auto nextStart = std::chrono::steady_clock::now();
+			SOCKET winner = INVALID_SOCKET;
+			std::size_t winnerCandidate = 0;
+
+			//	a cancellation wakes up the wait for the attempts
+			if (m_cancelToken) {
+				reactor.add(m_cancelToken->getWaitHandle(), EVENT_READ, [](SOCKET, std::uint32_t) {});
+			}
+
+			try {
+				while (winner == INVALID_SOCKET) {
+					//	check if any interrupt happened by user
+					if (m_callbackInterrupt && m_callbackInterrupt(*this)) {
+						throw general::SocketException(INTERRUPT_MSG);
+					}
+					if (m_cancelToken && m_cancelToken->isCancelled()) {
+						throw general::SocketException(CANCEL_MSG);
+					}
+
+					const auto now = std::chrono::steady_clock::now();
+					if (nextCandidate < candidates.size() && (attempts.empty() || now >= nextStart)) {
+						const auto candidate = nextCandidate++;
+						const auto* address = candidates[candidate].data();
+						const SOCKET socketId = socket(address->sa_family, SOCK_STREAM, 0);
+						if (socketId == INVALID_SOCKET) {
+							lastError = WSAGetLastError();
+							continue;
+						}
+
+						copySocketOptions(m_socketId, socketId);
+						unsigned long nonBlocking = 1;
+						(void)ioctlsocket(socketId, FIONBIO, &nonBlocking);
+
+						if (::connect(socketId, address, candidates[candidate].size()) != SOCKET_ERROR) {
+							attempts.push_back(Attempt{ socketId, candidate });
+							winner = socketId;
+							winnerCandidate = candidate;
+							break;
+						}
+
+						const int connectError = WSAGetLastError();
+						if (connectError != WSAEINPROGRESS && connectError != WSAEWOULDBLOCK) {
+							closeSocket(socketId);
+							lastError = connectError;
+							continue; // the next candidate starts right away
+						}
+
+						reactor.add(socketId, EVENT_WRITE, [&readySockets](SOCKET readySocket, std::uint32_t) {
+							readySockets.push_back(readySocket);
+						});
+						attempts.push_back(Attempt{ socketId, candidate });
+						nextStart = now + CONNECTION_ATTEMPT_DELAY;
+						continue;
+					}
+
+					if (attempts.empty()) {
+						throw general::SocketException(lastError != 0 ? lastError : WSAEWOULDBLOCK);
+					}
+
+					//	wait for an attempt to complete, but not beyond the start of the next one
+					auto waitTime = std::chrono::milliseconds{ RACE_WAIT_SLICE };
+					if (nextCandidate < candidates.size()) {
+						const auto untilNext = std::chrono::duration_cast<std::chrono::milliseconds>(nextStart - now);
+						waitTime = (std::max)(std::chrono::milliseconds{ 0 }, (std::min)(untilNext, waitTime));
+					}
+
+					readySockets.clear();
+					(void)reactor.runOnce(static_cast<int>(waitTime.count()));
+					for (const auto readySocket : readySockets) {
+						int socketError = 0;
+						socklen_t errorSize = sizeof(socketError);
+						if (getsockopt(readySocket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&socketError), &errorSize) == SOCKET_ERROR) {
+							socketError = WSAGetLastError();
+						}
+
+						const auto attempt = std::find_if(attempts.begin(), attempts.end(),
+							[readySocket](const Attempt& item) { return item.socketId == readySocket; });
+						if (socketError == 0) {
+							winner = readySocket;
+							winnerCandidate = attempt->candidate;
+							break;
+						}
+
+						//	a failed attempt lets the next candidate start immediately
+						lastError = socketError;
+						reactor.remove(readySocket);
+						closeSocket(readySocket);
+						attempts.erase(attempt);
+						nextStart = now;
+					}
+				}
+			}
+			catch (...) {
+				closeAttempts(INVALID_SOCKET);
+				throw;
+			}
+			closeAttempts(winner);
+
+			//	the winner replaces the socket of the object with the blocking mode of the old one,
+			//	Windows cannot query the mode, so the mode set through SocketOption is used there
+			bool nonBlocking = m_nonBlocking;
+#ifndef _WIN32
+			const int flags = fcntl(m_socketId, F_GETFL, 0);
+			if (flags != -1) {
+				nonBlocking = (flags & O_NONBLOCK) != 0;
+			}
+#endif
+			if (!nonBlocking) {
+				unsigned long blockingMode = 0;
+				(void)ioctlsocket(winner, FIONBIO, &blockingMode);
+			}
+			closeSocket(m_socketId);
+			m_socketId = winner;
+
+			const auto& address = candidates[winnerCandidate];
+			if (address.data()->sa_family == AF_INET6) {
+				m_ipVersion = IpVersion::IPv6;
+				std::memcpy(&m_sockAddressIpv6, address.data(), sizeof(m_sockAddressIpv6));
+			}
+			else {
+				m_ipVersion = IpVersion::IPv4;
+				std::memcpy(&m_sockAddressIpv4, address.data(), sizeof(m_sockAddressIpv4));
+			}
+		}
+
 		void Socket::bind()
 		{
 			const int addressSize = (m_ipVersion == IpVersion::IPv4 ? sizeof(m_sockAddressIpv4) : sizeof(m_sockAddressIpv6));
@@ -211,16 +494,33 @@ namespace sdk {
 		SOCKET Socket::accept()
 		{
 			if (m_protocolType != ProtocolType::udp) {
-#ifdef _WIN32
-				constexpr struct timeval timeout{ 0, DEFAULT_TIMEOUT };
-#else
-				struct timeval timeout{ 0, DEFAULT_TIMEOUT };
-#endif
 				socklen_t addrLen = m_ipVersion == IpVersion::IPv4 ? sizeof(m_sockAddressIpv4) : sizeof(m_sockAddressIpv6);
 				SOCKET newSockId{};
 
 				auto* stAddress = (m_ipVersion == IpVersion::IPv4 ? reinterpret_cast<sockaddr*>(&m_sockAddressIpv4) : reinterpret_cast<sockaddr*>(&m_sockAddressIpv6));
 
+#if IO_URING_SUPPORTED
+				if (m_ioEngine == IoEngine::ioUring) {
+					auto& ring = IoUring::threadInstance();
+					//	without an interrupt callback the ring waits until a connection arrives or the token is cancelled
+					while ((newSockId = ring.accept(m_socketId, m_callbackInterrupt ? DEFAULT_TIMEOUT : -1, m_cancelToken.get())) == INVALID_SOCKET) {
+						//	check if any interrupt happened by user
+						if (m_callbackInterrupt && m_callbackInterrupt(*this)) {
+							throw general::SocketException(INTERRUPT_MSG);
+						}
+						if (m_cancelToken && m_cancelToken->isCancelled()) {
+							throw general::SocketException(CANCEL_MSG);
+						}
+
+						const auto lasterror = WSAGetLastError();
+						if (lasterror != WSAEWOULDBLOCK) {
+							throw general::SocketException(lasterror);
+						}
+					}
+					return newSockId;
+				}
+#endif
+
 				while ((newSockId = ::accept(m_socketId, stAddress, &addrLen)) == INVALID_SOCKET) {
 					//	check if any interrupt happened by user
 					if (m_callbackInterrupt && m_callbackInterrupt(*this)) {
@@ -229,26 +529,17 @@ namespace sdk {
 
 					switch (const auto lasterror = WSAGetLastError()) {
 					case WSAEWOULDBLOCK: {
-						fd_set readFds{};
-						fd_set exceptFds{};
-
 						while (true) {
 							if (m_callbackInterrupt && m_callbackInterrupt(*this)) {
 								throw general::SocketException(INTERRUPT_MSG);
 							}
 
-							FD_ZERO(&readFds);
-							FD_SET(m_socketId, &readFds);
-							FD_ZERO(&exceptFds);
-							FD_SET(m_socketId, &exceptFds);
-						    const auto err = select(static_cast<int>(m_socketId) + 1, &readFds, nullptr, &exceptFds, &timeout);
-							if (err < 0) {
-								throw general::SocketException(WSAGetLastError());
-							}
-							if (FD_ISSET(m_socketId, &exceptFds)) {
+							//	without an interrupt callback there is nothing to check until the socket or the token is ready
+							const auto events = Reactor::waitFor(m_socketId, EVENT_READ, m_callbackInterrupt ? DEFAULT_TIMEOUT : -1, m_cancelToken.get());
+							if ((events & EVENT_ERROR) != 0) {
 								throw general::SocketException("Cannot connect to the server");
 							}
-							if (FD_ISSET(m_socketId, &readFds)) {
+							if ((events & EVENT_READ) != 0) {
 								break;
 							}
 						}
@@ -264,14 +555,146 @@ namespace sdk {
 			return 0;
 		}
 
+		std::size_t Socket::acceptBatch(std::vector<SOCKET>& socketIds, std::size_t maxCount /*= DEFAULT_ACCEPT_BATCH*/,
+			bool copyOptions /*= false*/)
+		{
+			if (m_protocolType == ProtocolType::udp) {
+				return 0;
+			}
+
+			std::size_t acceptCount = 0;
+			while (acceptCount < maxCount) {
+#if defined(__linux__) || defined(__FreeBSD__)
+				const SOCKET newSockId = ::accept4(m_socketId, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#else
+				const SOCKET newSockId = ::accept(m_socketId, nullptr, nullptr);
+#endif
+				if (newSockId == INVALID_SOCKET) {
+					const auto lasterror = WSAGetLastError();
+					if (lasterror == WSAEWOULDBLOCK) {
+						break; // the backlog is drained
+					}
+					if (isAbortedConnection(lasterror)) {
+						continue;
+					}
+					if (acceptCount > 0) {
+						break; // the accepted ones are handed over, the error comes again on the next call
+					}
+					throw general::SocketException(lasterror);
+				}
+
+#if !defined(__linux__) && !defined(__FreeBSD__)
+				unsigned long nonBlocking = 1;
+				if (ioctlsocket(newSockId, FIONBIO, &nonBlocking) == SOCKET_ERROR) {
+					const auto lasterror = WSAGetLastError();
+					closeSocket(newSockId);
+					if (acceptCount > 0) {
+						break;
+					}
+					throw general::SocketException(lasterror);
+				}
+#ifndef _WIN32
+				(void)fcntl(newSockId, F_SETFD, FD_CLOEXEC);
+#endif
+#endif
+				if (copyOptions) {
+					copySocketOptions(m_socketId, newSockId);
+				}
+
+				socketIds.push_back(newSockId);
+				++acceptCount;
+			}
+
+			return acceptCount;
+		}
+
 		std::shared_ptr<SocketDescriptor> Socket::createSocketDescriptor(SOCKET socketId)
 		{
 			return std::make_shared<SocketDescriptor>(socketId, *this);
 		}
 
+#if SOCKET_COROUTINES_SUPPORTED
+		Task<void> Socket::asyncConnect(EventLoop& loop)
+		{
+			fillAddrInfo();
+
+			const int addressSize = (m_ipVersion == IpVersion::IPv4 ? sizeof(m_sockAddressIpv4) : sizeof(m_sockAddressIpv6));
+
+			const auto* stAddress = (m_ipVersion == IpVersion::IPv4 ? reinterpret_cast<const sockaddr*>(&m_sockAddressIpv4) : reinterpret_cast<const sockaddr*>(&m_sockAddressIpv6));
+
+			if (::connect(m_socketId, stAddress, addressSize) != SOCKET_ERROR) {
+				co_return;
+			}
+
+			switch (const int lastError = WSAGetLastError()) {
+			case WSAEINPROGRESS:
+			case WSAEWOULDBLOCK:
+				break;
+			case WSAEISCONN:
+				co_return;
+			default:
+				throw general::SocketException(lastError);
+			}
+
+			//	check if any interrupt happened by user
+			if (m_callbackInterrupt && m_callbackInterrupt(*this)) {
+				throw general::SocketException(INTERRUPT_MSG);
+			}
+
+			co_await loop.waitFor(m_socketId, EVENT_WRITE);
+
+			int connectError{};
+			socklen_t optLen = sizeof(connectError);
+			if (getsockopt(m_socketId, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&connectError), &optLen) == SOCKET_ERROR) {
+				throw general::SocketException(WSAGetLastError());
+			}
+			if (connectError != 0) {
+				throw general::SocketException(connectError);
+			}
+		}
+
+		Task<SOCKET> Socket::asyncAccept(EventLoop& loop)
+		{
+			auto* stAddress = (m_ipVersion == IpVersion::IPv4 ? reinterpret_cast<sockaddr*>(&m_sockAddressIpv4) : reinterpret_cast<sockaddr*>(&m_sockAddressIpv6));
+
+			while (true) {
+				socklen_t addrLen = m_ipVersion == IpVersion::IPv4 ? sizeof(m_sockAddressIpv4) : sizeof(m_sockAddressIpv6);
+				const SOCKET newSockId = ::accept(m_socketId, stAddress, &addrLen);
+				if (newSockId != INVALID_SOCKET) {
+					co_return newSockId;
+				}
+
+				const auto lasterror = WSAGetLastError();
+				if (lasterror != WSAEWOULDBLOCK) {
+					throw general::SocketException(lasterror);
+				}
+
+				//	check if any interrupt happened by user
+				if (m_callbackInterrupt && m_callbackInterrupt(*this)) {
+					throw general::SocketException(INTERRUPT_MSG);
+				}
+
+				co_await loop.waitFor(m_socketId, EVENT_READ);
+			}
+		}
+#endif // SOCKET_COROUTINES_SUPPORTED
+
 		void Socket::setInterruptCallback(const socketInterruptCallback& callback) noexcept
 		{
 			m_callbackInterrupt = callback;
 		}
+
+		IoEngine Socket::setIoEngine(IoEngine engine) noexcept
+		{
+			m_ioEngine = IoEngine::poll;
+#if IO_URING_SUPPORTED
+			if (engine == IoEngine::ioUring && IoUring::isSupported()) {
+				m_ioEngine = IoEngine::ioUring;
+			}
+#else
+			(void)engine;
+#endif
+			return m_ioEngine;
+		}
 	}
 }
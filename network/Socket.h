@@ -27,8 +27,10 @@
 #include <memory>
 #include <functional>
 #include "SocketDescriptor.h"
+#include "CancellationToken.h"
 
 #include <cstdint>
+#include <vector>
 
 #if (__cplusplus >= 201703L)
 #define INLINE inline
@@ -59,6 +61,11 @@ namespace sdk {
 			IPv6 = AF_INET6
 		};
 
+		enum class IoEngine : std::uint8_t {
+			poll = 1, // readiness based system calls (poll/epoll)
+			ioUring   // io_uring requests, Linux only
+		};
+
 		// Useful WSA socket DLL versions
 		enum : std::uint16_t {
 			WSA_VER_1_0 = MakeVer(1, 0),
@@ -70,6 +77,9 @@ namespace sdk {
 
 		INLINE constexpr auto const INTERRUPT_MSG = "I/O interrupt callback is called by user.";
 
+		// maximum count of connections that acceptBatch() takes per call by default
+		INLINE constexpr std::size_t const DEFAULT_ACCEPT_BATCH = 64;
+
 		class Socket; // forward declaration
 
 		//	socket interrupt callback
@@ -82,6 +92,9 @@ namespace sdk {
 		class SOCKET_API Socket {
 			friend class SocketDescriptor;
 			friend class SSLSocketDescriptor;
+			friend class DatagramDescriptor;
+			template <typename T>
+			friend class SocketOption;
 
 		public:
 			explicit Socket(int portNumber, ProtocolType type = ProtocolType::tcp,
@@ -138,6 +151,23 @@ namespace sdk {
 			 */
 			NODISCARD virtual SOCKET accept();
 
+			/**
+			 * @brief Accepts the pending connections without waiting, until the backlog is drained
+			 * or the batch is full. The accepted sockets are non-blocking and close-on-exec, on Linux
+			 * they are created so by accept4 without extra system calls. The listening socket must be
+			 * in non-blocking mode. This function is useless for udp connections.
+			 * @param socketIds The ids of accepted sockets are appended to it, the caller owns them.
+			 * @param maxCount Maximum count of connections to accept.
+			 * @param copyOptions Copies the options that connect() passes on to a racing attempt, from
+			 * the listening socket to the accepted ones. Most platforms already pass them on, so it is only needed
+			 * where they must be enforced.
+			 * @return The count of accepted connections, 0 if no connection is pending.
+			 * @exception this function throws an SocketException if an error occurs before the first
+			 * connection is accepted, later errors are reported by the next call.
+			 */
+			NODISCARD std::size_t acceptBatch(std::vector<SOCKET>& socketIds, std::size_t maxCount = DEFAULT_ACCEPT_BATCH,
+				bool copyOptions = false);
+
 			/**
 			 * @brief This function creates an instance of socket descriptor.
 			 * @param socketId: The id of socket.
@@ -145,6 +175,27 @@ namespace sdk {
 			 */
 			NODISCARD std::shared_ptr<SocketDescriptor> createSocketDescriptor(SOCKET socketId);
 
+#if SOCKET_COROUTINES_SUPPORTED
+			/**
+			 * @brief Connects to the server without blocking the thread. The coroutine is suspended on
+			 * the loop until the connection completes. The socket must be in non-blocking mode.
+			 * Name resolution is still done synchronously.
+			 * @param loop The event loop that resumes the coroutine.
+			 * @return A task that completes when the socket is connected.
+			 * @exception the task throws an SocketException if an error occurs.
+			 */
+			NODISCARD Task<void> asyncConnect(EventLoop& loop);
+
+			/**
+			 * @brief Accepts an incoming connection without blocking the thread. The coroutine is
+			 * suspended on the loop until a connection is pending. The socket must be in non-blocking mode.
+			 * @param loop The event loop that resumes the coroutine.
+			 * @return A task that yields the id of accepted socket.
+			 * @exception the task throws an SocketException if an error occurs.
+			 */
+			NODISCARD Task<SOCKET> asyncAccept(EventLoop& loop);
+#endif // SOCKET_COROUTINES_SUPPORTED
+
 			/**
 			 * @brief This function is useful for client applications to set an ip address.
 			 * @param ipAddress Ip address.
@@ -187,12 +238,95 @@ namespace sdk {
 				return m_portNumber;
 			}
 
+			/**
+			 * @brief This function returns protocol type of the socket.
+			 * @return Protocol type.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD ProtocolType getProtocolType() const noexcept
+			{
+				return m_protocolType;
+			}
+
+			/**
+			 * @brief This function returns ip version of the socket.
+			 * @return Ip version.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD IpVersion getIpVersion() const noexcept
+			{
+				return m_ipVersion;
+			}
+
 			void setInterruptCallback(const socketInterruptCallback& callback) noexcept;
 
+			/**
+			 * @brief Sets the token that cancels the blocking operations of the socket and its descriptors.
+			 * A cancelled operation throws an SocketException with CANCEL_MSG. Without an interrupt
+			 * callback, accept() and connect() wait without waking up until the socket or the token is ready.
+			 * @param cancelToken The token, it may be shared by many sockets.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void setCancellationToken(std::shared_ptr<CancellationToken> cancelToken) noexcept
+			{
+				m_cancelToken = std::move(cancelToken);
+			}
+
+			NODISCARD const CancellationToken* getCancellationToken() const noexcept
+			{
+				return m_cancelToken.get();
+			}
+
+			/**
+			 * @brief This function selects the I/O engine used by the socket and its descriptors.
+			 * If the requested engine is not supported by the library or the kernel, the poll engine is used.
+			 * @param engine The I/O engine.
+			 * @return The I/O engine that is actually selected.
+			 * @exception This function never throws an exception.
+			 */
+			IoEngine setIoEngine(IoEngine engine) noexcept;
+
+			/**
+			 * @brief Enables connection racing (RFC 8305 Happy Eyeballs) for tcp clients.
+			 * connect() then resolves both IPv6 and IPv4 addresses of the host and starts a new attempt
+			 * every 250 milliseconds, or right after an attempt fails, until one of them completes.
+			 * The socket of the winning attempt replaces the socket of this object and the ip version
+			 * follows its address family. Every option that SocketOption sets on a connecting socket (debug,
+			 * reuse address and port, zero copy, keep alive, linger, timeouts, no delay) and the buffer sizes
+			 * of the original socket are copied to the attempts, so is the blocking mode. Other options that
+			 * are set directly on the socket id are lost. A socket that is bound to a local address keeps
+			 * its address and connects without racing.
+			 * @param enable Racing is used if true.
+			 * @return nothing.
+			 * @exception This function never throws an exception.
+			 */
+			void setHappyEyeballs(bool enable) noexcept
+			{
+				m_happyEyeballs = enable;
+			}
+
+			NODISCARD bool getHappyEyeballs() const noexcept
+			{
+				return m_happyEyeballs;
+			}
+
+			/**
+			 * @brief This function returns the I/O engine used by the socket.
+			 * @return The I/O engine.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD IoEngine getIoEngine() const noexcept
+			{
+				return m_ioEngine;
+			}
+
 		protected:
 			void fillAddrInfo();
 
 		private:
+			void connectHappyEyeballs();
+
 			static bool m_wsaInit;
 
 			int m_portNumber{};
@@ -201,8 +335,13 @@ namespace sdk {
 			struct sockaddr_in m_sockAddressIpv4{}; // Stores address information.
 			struct sockaddr_in6 m_sockAddressIpv6{};
 			socketInterruptCallback m_callbackInterrupt;
+			std::shared_ptr<CancellationToken> m_cancelToken;
 			std::string m_ipAddress;
 			IpVersion m_ipVersion{ IpVersion::IPv4 };
+			IoEngine m_ioEngine{ IoEngine::poll };
+			bool m_happyEyeballs{};
+			mutable bool m_nonBlocking{}; // mode set through SocketOption, Windows cannot query it
+			mutable std::atomic<std::uint32_t> m_recvTimeoutVersion{}; // bumped by SocketOption, descriptors drop their cached timeout
 		};
 	}
 }
@@ -24,14 +24,70 @@
 #include "Socket.h"
 #include "SocketException.h"
 #include "SocketOption.h"
+#include "Reactor.h"
+#include "IoUring.h"
+#include "EventLoop.h"
 
-#include <iterator>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/uio.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/sendfile.h>
+#include <linux/errqueue.h>
+#endif
 
 namespace sdk {
 	namespace network {
 
 		namespace {
 			constexpr const auto DEFAULT_RECV_TIMEOUT = 5L;
+			constexpr const std::size_t MAX_IO_BUFFERS = 64; // buffers per system call, IOV_MAX is at least 16
+			constexpr const std::size_t FILE_CHUNK_SIZE = 65536;
+			constexpr const int WRITE_WAIT_SLICE = 100; // milliseconds, the interrupt callback is checked in between
+
+#ifdef MSG_DONTWAIT
+			constexpr const int SEND_NONBLOCKING = MSG_DONTWAIT; // keeps blocking sockets within the deadline
+#else
+			constexpr const int SEND_NONBLOCKING = 0;
+#endif
+
+			//	reads from the given file offset without moving the file position where possible
+			long long readFileAt(int fileFd, char* buffer, std::size_t size, std::int64_t offset) noexcept
+			{
+#ifdef _WIN32
+				if (_lseeki64(fileFd, offset, SEEK_SET) == -1) {
+					return -1;
+				}
+				return _read(fileFd, buffer, static_cast<unsigned int>(size));
+#else
+				return pread(fileFd, buffer, size, static_cast<off_t>(offset));
+#endif
+			}
+
+#ifdef _WIN32
+			using IoVector = WSABUF;
+
+			void setIoVector(IoVector& ioVector, const char* data, std::size_t size) noexcept
+			{
+				ioVector.buf = const_cast<char*>(data);
+				ioVector.len = static_cast<ULONG>((std::min)(size, static_cast<std::size_t>(ULONG_MAX)));
+			}
+#else
+			using IoVector = struct iovec;
+
+			void setIoVector(IoVector& ioVector, const char* data, std::size_t size) noexcept
+			{
+				ioVector.iov_base = const_cast<char*>(data);
+				ioVector.iov_len = size;
+			}
+#endif
 		}
 
 		SocketDescriptor::SocketDescriptor(SOCKET socketId, const Socket& socketRef) noexcept :
@@ -55,108 +111,180 @@ namespace sdk {
 
 		std::string SocketDescriptor::read(int maxSize /*= 0*/) const
 		{
-			const int bufLen = (maxSize > 0 && maxSize < MAX_MESSAGE_SIZE) ? maxSize : MAX_MESSAGE_SIZE - 1;
-
 			std::string strMessage;
-			std::vector<char> dataVec(bufLen);
+			readAppend(strMessage, maxSize, getRecvTimeoutMs());
+			return strMessage;
+		}
 
-			int receiveByte{};
-			int iResult{};
-#ifdef _WIN32
-			constexpr struct timeval tVal = { 0, 0 };
-#else
-			struct timeval tVal = { 0, 0 };
+		template <typename Container>
+		void SocketDescriptor::readAppend(Container& message, int maxSize, int timeoutMs) const
+		{
+			//	A positive maxSize bounds the whole message. The message grows chunk by chunk
+			//	as long as the previous chunk was filled completely and more data is available.
+			const auto maxChunkSize = static_cast<std::size_t>(MAX_MESSAGE_SIZE - 1);
+			auto remaining = maxSize > 0 ? static_cast<std::size_t>(maxSize) : maxChunkSize;
+
+			while (true) {
+				const auto chunkSize = (std::min)(remaining, maxChunkSize);
+				const auto oldSize = message.size();
+				message.resize(oldSize + chunkSize);
+				const auto receiveByte = readAvailable(reinterpret_cast<char*>(&message[oldSize]), chunkSize, timeoutMs);
+				message.resize(oldSize + receiveByte);
+
+				if (receiveByte < chunkSize) {
+					break;
+				}
+
+				if (maxSize > 0) {
+					remaining -= receiveByte;
+					if (remaining == 0) {
+						break;
+					}
+				}
+
+				//	A blocking socket would wait in recv for data that may never come,
+				//	so only take the data that is already available.
+				if (!waitReadable(0)) {
+					break;
+				}
+				timeoutMs = 0;
+			}
+		}
+
+		std::size_t SocketDescriptor::readAvailable(char* buffer, std::size_t bufSize, int timeoutMs) const
+		{
+#if IO_URING_SUPPORTED
+			if (m_socketRef.m_ioEngine == IoEngine::ioUring) {
+				return readIoUring(buffer, bufSize, timeoutMs);
+			}
 #endif
-			fd_set readFds{};
-			fd_set exceptFds{};
+			std::size_t totalBytes = 0;
 
 			const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
 
-			const SocketOption<SocketDescriptor> socketOpt{ *this };
+			while (totalBytes < bufSize) {
+				const auto bufLen = static_cast<int>((std::min)(bufSize - totalBytes, static_cast<std::size_t>(INT_MAX)));
 
-			/*if (socketOpt.getBytesAvailable() == 0)
-				return strMessage;*/
-
-			while (true) {
-				while ((receiveByte = recv(m_socketId, dataVec.data(), bufLen, 0)) == SOCKET_ERROR) {
+				int receiveByte{};
+				while ((receiveByte = recv(m_socketId, buffer + totalBytes, bufLen, 0)) == SOCKET_ERROR) {
 					if (callbackInterrupt &&
 						callbackInterrupt(m_socketRef)) {
 						throw general::SocketException(INTERRUPT_MSG);
 					}
 
 					switch (const auto lasterror = WSAGetLastError()) {
-					case WSAEWOULDBLOCK: {
-						auto recvTimeout = socketOpt.getRecvTimeout();
-						//	The default value of recieve timeout is 0.
-						//	If a user decided to set timeout value, there is no problem at all.
-						//	Otherwise, set the default value to an acceptable timeout value.
-						if (recvTimeout.tv_sec == 0 &&
-							recvTimeout.tv_usec == 0) {
-							recvTimeout.tv_sec = DEFAULT_RECV_TIMEOUT;
-						}
-
-						FD_ZERO(&readFds);
-						FD_SET(m_socketId, &readFds);
-
-						iResult = select(static_cast<int>(m_socketId) + 1, &readFds, nullptr, nullptr, &recvTimeout);
-						if (iResult < 0) {
-							throw general::SocketException(WSAGetLastError());
+					case WSAEWOULDBLOCK:
+						if ((Reactor::waitFor(m_socketId, EVENT_READ, timeoutMs, m_socketRef.getCancellationToken()) & EVENT_READ) == 0) {
+							return totalBytes;
 						}
-						if (!FD_ISSET(m_socketId, &readFds)) {
-							return strMessage;
-						}
-					} break;
+						break;
 					default:
 						throw general::SocketException(lasterror);
 					}
 				}
 
 				if (receiveByte == 0) {
-					return strMessage; // the connection is closed.
+					break; // the connection is closed.
 				}
 
-				if (receiveByte > 0) {
-					std::move(dataVec.begin(), dataVec.begin() + receiveByte,
-						std::back_inserter(strMessage));
-				}
+				totalBytes += static_cast<std::size_t>(receiveByte);
 
 				if (callbackInterrupt &&
 					callbackInterrupt(m_socketRef)) {
 					throw general::SocketException(INTERRUPT_MSG);
 				}
 
-				if (maxSize > 0 && strMessage.size() >= static_cast<std::size_t>(maxSize)) {
+				if (totalBytes >= bufSize) {
 					break;
 				}
 
 				/*
 				 *	Wait for a while to detect if we reached the end of the data
-				 *	select will return immediately without waiting...
+				 *	poll will return immediately without waiting...
 				 */
 
-				FD_ZERO(&readFds);
-				FD_SET(m_socketId, &readFds);
-				FD_ZERO(&exceptFds);
-				FD_SET(m_socketId, &exceptFds);
-				iResult = select(static_cast<int>(m_socketId) + 1, &readFds, nullptr, &exceptFds, &tVal);
-				if (iResult < 0) {
-					throw general::SocketException(WSAGetLastError());
-				}
-				if (!FD_ISSET(m_socketId, &readFds) || FD_ISSET(m_socketId, &exceptFds)) {
-					break;
-				}
-				if (receiveByte <= 0) {
+				const auto events = Reactor::waitFor(m_socketId, EVENT_READ, 0);
+				if ((events & EVENT_READ) == 0 || (events & EVENT_ERROR) != 0) {
 					break;
 				}
 			}
 
-			return strMessage;
+			return totalBytes;
 		}
 
+		int SocketDescriptor::getRecvTimeoutMs() const
+		{
+			//	a timeout set through the Socket drops the cache too, the socket may be the same
+			const auto version = m_socketRef.m_recvTimeoutVersion.load(std::memory_order_acquire);
+			const int cachedTimeoutMs = m_recvTimeoutMs.load(std::memory_order_acquire);
+			if (cachedTimeoutMs != RECV_TIMEOUT_UNKNOWN && m_recvTimeoutVersion.load(std::memory_order_relaxed) == version) {
+				return cachedTimeoutMs; // no system call on the read path
+			}
+
+			const SocketOption<SocketDescriptor> socketOpt{ *this };
+
+			auto recvTimeout = socketOpt.getRecvTimeout();
+			//	The default value of recieve timeout is 0.
+			//	If a user decided to set timeout value, there is no problem at all.
+			//	Otherwise, set the default value to an acceptable timeout value.
+			if (recvTimeout.tv_sec == 0 &&
+				recvTimeout.tv_usec == 0) {
+				recvTimeout.tv_sec = DEFAULT_RECV_TIMEOUT;
+			}
+
+			const auto timeoutMs = static_cast<int>(recvTimeout.tv_sec * 1000 + recvTimeout.tv_usec / 1000);
+			m_recvTimeoutVersion.store(version, std::memory_order_relaxed);
+			m_recvTimeoutMs.store(timeoutMs, std::memory_order_release);
+			return timeoutMs;
+		}
+
+#if IO_URING_SUPPORTED
+		std::size_t SocketDescriptor::readIoUring(char* buffer, std::size_t bufSize, int timeoutMs) const
+		{
+			std::size_t totalBytes = 0;
+
+			auto& ring = IoUring::threadInstance();
+			const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
+
+			//	The first request waits for data with a linked timeout, the next ones only
+			//	take the data that is already available. Each request is a single system call.
+			while (totalBytes < bufSize) {
+				if (callbackInterrupt &&
+					callbackInterrupt(m_socketRef)) {
+					throw general::SocketException(INTERRUPT_MSG);
+				}
+
+				const auto bufLen = static_cast<int>((std::min)(bufSize - totalBytes, static_cast<std::size_t>(INT_MAX)));
+				const int receiveByte = ring.recv(m_socketId, buffer + totalBytes, bufLen, 0, timeoutMs);
+				if (receiveByte == SOCKET_ERROR) {
+					const auto lasterror = WSAGetLastError();
+					if (lasterror == WSAEWOULDBLOCK) {
+						break;
+					}
+					throw general::SocketException(lasterror);
+				}
+
+				if (receiveByte == 0) {
+					break; // the connection is closed.
+				}
+
+				totalBytes += static_cast<std::size_t>(receiveByte);
+				timeoutMs = 0;
+			}
+
+			return totalBytes;
+		}
+#endif // IO_URING_SUPPORTED
 
 		std::size_t SocketDescriptor::read(char& msgByte) const
 		{
+#if IO_URING_SUPPORTED
+			int const numBytes = (m_socketRef.m_ioEngine == IoEngine::ioUring) ?
+				IoUring::threadInstance().recv(m_socketId, &msgByte, 1, 0) :
+				recv(m_socketId, &msgByte, 1, 0);
+#else
 			int const numBytes = recv(m_socketId, &msgByte, 1, 0);
+#endif
 			if (numBytes < 0) {
 				throw general::SocketException(WSAGetLastError());
 			}
@@ -165,17 +293,65 @@ namespace sdk {
 
 		std::size_t SocketDescriptor::read(std::vector<unsigned char>& message, int maxSize /*= 0*/) const
 		{
-			const auto receivedStr = read(maxSize);
-			std::move(receivedStr.begin(), receivedStr.end(), std::back_inserter(message));
+			readAppend(message, maxSize, getRecvTimeoutMs());
 			return message.size();
 		}
 
 		std::size_t SocketDescriptor::read(std::string& message, int maxSize /*= 0*/) const
 		{
-			message = read(maxSize);
+			message.clear(); // keeps the capacity of the caller's string
+			readAppend(message, maxSize, getRecvTimeoutMs());
 			return message.size();
 		}
 
+		std::size_t SocketDescriptor::read(std::string& message, std::chrono::steady_clock::time_point deadline,
+			int maxSize /*= 0*/) const
+		{
+			message.clear();
+			if (waitReadable(getRemainingMs(deadline))) {
+				readAppend(message, maxSize, getRemainingMs(deadline));
+			}
+			return message.size();
+		}
+
+		std::size_t SocketDescriptor::read(char* buffer, std::size_t bufSize) const
+		{
+			return readAvailable(buffer, bufSize, getRecvTimeoutMs());
+		}
+
+		std::size_t SocketDescriptor::read(char* buffer, std::size_t bufSize, std::chrono::steady_clock::time_point deadline) const
+		{
+			if (!waitReadable(getRemainingMs(deadline))) {
+				return 0;
+			}
+			return readAvailable(buffer, bufSize, getRemainingMs(deadline));
+		}
+
+		bool SocketDescriptor::waitReadable(int timeoutMs) const
+		{
+			return Reactor::waitFor(m_socketId, EVENT_READ, timeoutMs, m_socketRef.getCancellationToken()) != EVENT_NONE;
+		}
+
+		PooledBuffer SocketDescriptor::read(BufferPool& pool, std::size_t maxSize /*= 0*/) const
+		{
+			auto buffer = pool.acquire(maxSize > 0 ? maxSize : MAX_MESSAGE_SIZE - 1);
+			const auto bufSize = maxSize > 0 ? maxSize : buffer.capacity();
+			buffer.setSize(readAvailable(buffer.data(), bufSize, getRecvTimeoutMs()));
+			return buffer;
+		}
+
+		std::size_t SocketDescriptor::read(RingBuffer& ring) const
+		{
+			if (ring.writableSize() == 0) {
+				throw general::SocketException("The ring buffer is full.");
+			}
+
+			char* freeSpace = ring.writeData();
+			const auto readBytes = readAvailable(freeSpace, ring.writableSize(), getRecvTimeoutMs());
+			ring.commit(readBytes);
+			return readBytes;
+		}
+
 		int SocketDescriptor::write(std::initializer_list<char> dataList)
 		{
 			return write(dataList.begin(), static_cast<int>(dataList.size()));
@@ -187,6 +363,25 @@ namespace sdk {
 
 			const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
 
+#if IO_URING_SUPPORTED
+			if (m_socketRef.m_ioEngine == IoEngine::ioUring) {
+				auto& ring = IoUring::threadInstance();
+				while ((sendBytes = ring.send(m_socketId, data, dataSize, 0)) == SOCKET_ERROR) {
+					if (callbackInterrupt &&
+						callbackInterrupt(m_socketRef)) {
+						throw general::SocketException(INTERRUPT_MSG);
+					}
+
+					const auto lasterror = WSAGetLastError();
+					if (lasterror != WSAEWOULDBLOCK) {
+						throw general::SocketException(lasterror);
+					}
+					(void)Reactor::waitFor(m_socketId, EVENT_WRITE, WRITE_WAIT_SLICE, m_socketRef.getCancellationToken());
+				}
+				return sendBytes;
+			}
+#endif
+
 			while ((sendBytes = send(m_socketId, data, dataSize, 0)) == SOCKET_ERROR) {
 				if (callbackInterrupt &&
 					callbackInterrupt(m_socketRef)) {
@@ -195,6 +390,8 @@ namespace sdk {
 
 				switch (const auto lasterror = WSAGetLastError()) {
 				case WSAEWOULDBLOCK:
+					// the send buffer is full, wait until the peer drains it
+					(void)Reactor::waitFor(m_socketId, EVENT_WRITE, WRITE_WAIT_SLICE, m_socketRef.getCancellationToken());
 					break;
 				default:
 					throw general::SocketException(lasterror);
@@ -204,15 +401,419 @@ namespace sdk {
 			return sendBytes;
 		}
 
+		std::size_t SocketDescriptor::gatherWrite(const ConstBuffer* buffers, std::size_t count)
+		{
+			IoVector ioVectors[MAX_IO_BUFFERS];
+			count = (std::min)(count, MAX_IO_BUFFERS); // the rest is reported as not written
+			for (std::size_t i = 0; i < count; ++i) {
+				setIoVector(ioVectors[i], buffers[i].data, buffers[i].size);
+			}
+
+			const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
+
+			while (true) {
+#ifdef _WIN32
+				DWORD sendBytes{};
+				const auto result = WSASend(m_socketId, ioVectors, static_cast<DWORD>(count), &sendBytes, 0, nullptr, nullptr);
+#else
+				struct msghdr message{};
+				message.msg_iov = ioVectors;
+				message.msg_iovlen = count;
+				const auto sendBytes = sendmsg(m_socketId, &message, 0);
+				const auto result = sendBytes;
+#endif
+				if (result != SOCKET_ERROR) {
+					return static_cast<std::size_t>(sendBytes);
+				}
+
+				if (callbackInterrupt &&
+					callbackInterrupt(m_socketRef)) {
+					throw general::SocketException(INTERRUPT_MSG);
+				}
+
+				const auto lasterror = WSAGetLastError();
+				if (lasterror != WSAEWOULDBLOCK) {
+					throw general::SocketException(lasterror);
+				}
+
+				(void)Reactor::waitFor(m_socketId, EVENT_WRITE, WRITE_WAIT_SLICE, m_socketRef.getCancellationToken());
+			}
+		}
+
+		std::size_t SocketDescriptor::scatterRead(const MutableBuffer* buffers, std::size_t count) const
+		{
+			IoVector ioVectors[MAX_IO_BUFFERS];
+			count = (std::min)(count, MAX_IO_BUFFERS);
+			for (std::size_t i = 0; i < count; ++i) {
+				setIoVector(ioVectors[i], buffers[i].data, buffers[i].size);
+			}
+
+			const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
+
+			while (true) {
+#ifdef _WIN32
+				DWORD receiveBytes{};
+				DWORD flags{};
+				const auto result = WSARecv(m_socketId, ioVectors, static_cast<DWORD>(count), &receiveBytes, &flags, nullptr, nullptr);
+#else
+				struct msghdr message{};
+				message.msg_iov = ioVectors;
+				message.msg_iovlen = count;
+				const auto receiveBytes = recvmsg(m_socketId, &message, 0);
+				const auto result = receiveBytes;
+#endif
+				if (result != SOCKET_ERROR) {
+					return static_cast<std::size_t>(receiveBytes);
+				}
+
+				if (callbackInterrupt &&
+					callbackInterrupt(m_socketRef)) {
+					throw general::SocketException(INTERRUPT_MSG);
+				}
+
+				const auto lasterror = WSAGetLastError();
+				if (lasterror != WSAEWOULDBLOCK) {
+					throw general::SocketException(lasterror);
+				}
+
+				if ((Reactor::waitFor(m_socketId, EVENT_READ, getRecvTimeoutMs(), m_socketRef.getCancellationToken()) & EVENT_READ) == 0) {
+					return 0;
+				}
+			}
+		}
+
+		std::size_t SocketDescriptor::sendFile(int fileFd, std::int64_t& offset, std::size_t length)
+		{
+#if defined(__linux__) || defined(__APPLE__)
+			std::size_t totalBytes = 0;
+
+			const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
+
+			while (totalBytes < length) {
+#if defined(__linux__)
+				auto fileOffset = static_cast<off_t>(offset);
+				const auto sendBytes = ::sendfile(static_cast<int>(m_socketId), fileFd, &fileOffset, length - totalBytes);
+				const auto result = sendBytes;
+#else
+				// the byte count that sent is reported even if the call fails with EAGAIN
+				auto sendBytes = static_cast<off_t>(length - totalBytes);
+				const auto result = ::sendfile(fileFd, static_cast<int>(m_socketId), static_cast<off_t>(offset), &sendBytes, nullptr, 0);
+#endif
+				if (sendBytes > 0) {
+					offset += sendBytes;
+					totalBytes += static_cast<std::size_t>(sendBytes);
+				}
+
+				if (result != SOCKET_ERROR) {
+					if (sendBytes == 0) {
+						break; // end of file
+					}
+					continue;
+				}
+
+				if (callbackInterrupt &&
+					callbackInterrupt(m_socketRef)) {
+					throw general::SocketException(INTERRUPT_MSG);
+				}
+
+				switch (const auto lasterror = WSAGetLastError()) {
+				case WSAEWOULDBLOCK:
+					return totalBytes; // partial progress, the caller waits for writability
+				case EINTR:
+					break;
+				default:
+					throw general::SocketException(lasterror);
+				}
+			}
+
+			return totalBytes;
+#else
+			return sendFileChunked(fileFd, offset, length);
+#endif
+		}
+
+		std::size_t SocketDescriptor::sendFileChunked(int fileFd, std::int64_t& offset, std::size_t length)
+		{
+			auto chunk = BufferPool::defaultPool().acquire(FILE_CHUNK_SIZE);
+			std::size_t totalBytes = 0;
+
+			while (totalBytes < length) {
+				const auto chunkSize = (std::min)(length - totalBytes, chunk.capacity());
+				const auto readBytes = readFileAt(fileFd, chunk.data(), chunkSize, offset);
+				if (readBytes < 0) {
+					throw general::SocketException(errno);
+				}
+				if (readBytes == 0) {
+					break; // end of file
+				}
+
+				const auto sendBytes = write(chunk.data(), static_cast<int>(readBytes));
+				offset += sendBytes;
+				totalBytes += static_cast<std::size_t>(sendBytes);
+				if (sendBytes < readBytes) {
+					break; // partial progress, the rest of the chunk is read again on the next call
+				}
+			}
+
+			return totalBytes;
+		}
+
+		std::size_t SocketDescriptor::writeZeroCopy(const char* data, std::size_t dataSize, std::uint32_t& sequence)
+		{
+#if defined(__linux__) && defined(MSG_ZEROCOPY)
+			if (m_zeroCopyState == ZeroCopyState::unknown) {
+				const SocketOption<SocketDescriptor> socketOpt{ *this };
+				m_zeroCopyState = socketOpt.getZeroCopy() != 0 ? ZeroCopyState::enabled : ZeroCopyState::disabled;
+			}
+
+			if (m_zeroCopyState == ZeroCopyState::enabled) {
+				const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
+
+				ssize_t sendBytes{};
+				while ((sendBytes = send(m_socketId, data, dataSize, MSG_ZEROCOPY)) == SOCKET_ERROR) {
+					if (callbackInterrupt &&
+						callbackInterrupt(m_socketRef)) {
+						throw general::SocketException(INTERRUPT_MSG);
+					}
+
+					switch (const auto lasterror = WSAGetLastError()) {
+					case WSAEWOULDBLOCK:
+						(void)Reactor::waitFor(m_socketId, EVENT_WRITE, WRITE_WAIT_SLICE, m_socketRef.getCancellationToken());
+						break;
+					case ENOBUFS:
+						//	too many sends are not completed yet, their notifications hold the option memory
+						//	of the socket. Reading them releases it, they are kept for the caller.
+						if (m_zeroCopyDone == m_zeroCopyNext) {
+							throw general::SocketException(lasterror); // nothing to wait for
+						}
+						(void)readZeroCopyCompletions(m_zeroCopyCompleted, WRITE_WAIT_SLICE);
+						break;
+					default:
+						throw general::SocketException(lasterror);
+					}
+				}
+
+				sequence = m_zeroCopyNext++;
+				return static_cast<std::size_t>(sendBytes);
+			}
+#endif
+			return writeCopied(data, dataSize, sequence);
+		}
+
+		std::size_t SocketDescriptor::writeCopied(const char* data, std::size_t dataSize, std::uint32_t& sequence)
+		{
+			const auto sendBytes = write(data, static_cast<int>((std::min)(dataSize, static_cast<std::size_t>(INT_MAX))));
+			sequence = m_zeroCopyNext++;
+			return static_cast<std::size_t>(sendBytes);
+		}
+
+		std::size_t SocketDescriptor::pollZeroCopyCompletions(std::vector<ZeroCopyCompletion>& completions, int timeoutMs /*= 0*/)
+		{
+			const auto oldCount = completions.size();
+
+#if defined(__linux__) && defined(MSG_ZEROCOPY)
+			if (m_zeroCopyState == ZeroCopyState::enabled) {
+				// the completions collected by the sends come first, they are older
+				if (!m_zeroCopyCompleted.empty()) {
+					completions.insert(completions.end(), m_zeroCopyCompleted.begin(), m_zeroCopyCompleted.end());
+					m_zeroCopyCompleted.clear();
+					timeoutMs = 0;
+				}
+
+				(void)readZeroCopyCompletions(completions, timeoutMs);
+				return completions.size() - oldCount;
+			}
+#endif
+			(void)timeoutMs;
+
+			// copied sends are completed as soon as they return
+			if (m_zeroCopyReported != m_zeroCopyNext) {
+				completions.push_back(ZeroCopyCompletion{ m_zeroCopyReported, m_zeroCopyNext - 1, true });
+				m_zeroCopyReported = m_zeroCopyNext;
+			}
+
+			return completions.size() - oldCount;
+		}
+
+		std::size_t SocketDescriptor::readZeroCopyCompletions(std::vector<ZeroCopyCompletion>& completions, int timeoutMs)
+		{
+			const auto oldCount = completions.size();
+
+#if defined(__linux__) && defined(MSG_ZEROCOPY)
+			//	pending completions are signaled as an error condition
+			if (timeoutMs != 0 &&
+				(Reactor::waitFor(m_socketId, EVENT_NONE, timeoutMs, m_socketRef.getCancellationToken()) & EVENT_ERROR) == 0) {
+				return 0;
+			}
+
+			while (true) {
+				char control[CMSG_SPACE(sizeof(struct sock_extended_err)) + CMSG_SPACE(sizeof(struct sockaddr_in6))];
+				struct msghdr message{};
+				message.msg_control = control;
+				message.msg_controllen = sizeof(control);
+
+				if (recvmsg(m_socketId, &message, MSG_ERRQUEUE) == SOCKET_ERROR) {
+					const auto lasterror = WSAGetLastError();
+					if (lasterror == WSAEWOULDBLOCK) {
+						break; // the error queue is empty
+					}
+					throw general::SocketException(lasterror);
+				}
+
+				for (auto* cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr; cmsg = CMSG_NXTHDR(&message, cmsg)) {
+					const bool isRecvErr = (cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+										   (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR);
+					if (!isRecvErr) {
+						continue;
+					}
+
+					struct sock_extended_err extendedErr{};
+					std::memcpy(&extendedErr, CMSG_DATA(cmsg), sizeof(extendedErr));
+					if (extendedErr.ee_errno != 0 || extendedErr.ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+						continue;
+					}
+
+					completions.push_back(ZeroCopyCompletion{ extendedErr.ee_info, extendedErr.ee_data,
+						(extendedErr.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0 });
+					m_zeroCopyDone += extendedErr.ee_data - extendedErr.ee_info + 1;
+				}
+			}
+#else
+			(void)timeoutMs;
+#endif
+			return completions.size() - oldCount;
+		}
+
+		std::size_t SocketDescriptor::writeAll(const char* data, std::size_t dataSize,
+			std::chrono::milliseconds timeout /*= std::chrono::milliseconds{ -1 }*/)
+		{
+			const auto deadline = std::chrono::steady_clock::now() + timeout;
+			std::size_t totalBytes = 0;
+
+			const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
+
+			while (totalBytes < dataSize) {
+				const auto bufLen = static_cast<int>((std::min)(dataSize - totalBytes, static_cast<std::size_t>(INT_MAX)));
+				const auto sendBytes = send(m_socketId, data + totalBytes, bufLen, SEND_NONBLOCKING);
+				if (sendBytes != SOCKET_ERROR) {
+					totalBytes += static_cast<std::size_t>(sendBytes);
+					continue;
+				}
+
+				if (callbackInterrupt &&
+					callbackInterrupt(m_socketRef)) {
+					throw general::SocketException(INTERRUPT_MSG);
+				}
+
+				const auto lasterror = WSAGetLastError();
+				if (lasterror != WSAEWOULDBLOCK) {
+					throw general::SocketException(lasterror);
+				}
+
+				const auto waitMs = getWaitSlice(deadline, timeout);
+				if (waitMs == 0) {
+					break; // the deadline expired, the caller gets the partial progress
+				}
+				(void)Reactor::waitFor(m_socketId, EVENT_WRITE, waitMs, m_socketRef.getCancellationToken());
+			}
+
+			return totalBytes;
+		}
+
+		std::size_t SocketDescriptor::writeAll(const char* data, std::size_t dataSize, std::chrono::steady_clock::time_point deadline)
+		{
+			//	a passed deadline still makes one attempt, like a zero timeout
+			return writeAll(data, dataSize, std::chrono::milliseconds{ getRemainingMs(deadline) });
+		}
+
+		int SocketDescriptor::getRemainingMs(std::chrono::steady_clock::time_point deadline) noexcept
+		{
+			const auto remaining = deadline - std::chrono::steady_clock::now();
+			if (remaining <= std::chrono::steady_clock::duration::zero()) {
+				return 0;
+			}
+
+			// rounded up, so the wait does not end just before the deadline
+			const auto remainingMs = std::chrono::duration_cast<std::chrono::milliseconds>(remaining +
+				std::chrono::milliseconds{ 1 } - std::chrono::steady_clock::duration{ 1 }).count();
+			return static_cast<int>((std::min)(remainingMs, static_cast<std::chrono::milliseconds::rep>(INT_MAX)));
+		}
+
+		int SocketDescriptor::getWaitSlice(std::chrono::steady_clock::time_point deadline,
+			std::chrono::milliseconds timeout) noexcept
+		{
+			if (timeout.count() < 0) {
+				return WRITE_WAIT_SLICE;
+			}
+
+			// rounded up like the deadline, so the write does not give up just before it
+			return (std::min)(getRemainingMs(deadline), WRITE_WAIT_SLICE);
+		}
+
 		int SocketDescriptor::write(const std::vector<unsigned char>& message)
 		{
-			const std::string strBuf{ message.begin(), message.end() };
-			return write(strBuf.c_str(), static_cast<int>(strBuf.size()));
+			return write(reinterpret_cast<const char*>(message.data()), static_cast<int>(message.size()));
 		}
 
 		int SocketDescriptor::write(const std::string& message)
 		{
 			return write(message.c_str(), static_cast<int>(message.size()));
 		}
+
+#if SOCKET_COROUTINES_SUPPORTED
+		Task<std::size_t> SocketDescriptor::asyncRead(EventLoop& loop, char* buffer, std::size_t bufSize)
+		{
+			const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
+
+			while (true) {
+				const auto bufLen = static_cast<int>((std::min)(bufSize, static_cast<std::size_t>(INT_MAX)));
+				const auto receiveByte = recv(m_socketId, buffer, bufLen, 0);
+				if (receiveByte != SOCKET_ERROR) {
+					co_return static_cast<std::size_t>(receiveByte);
+				}
+
+				const auto lasterror = WSAGetLastError();
+				if (lasterror != WSAEWOULDBLOCK) {
+					throw general::SocketException(lasterror);
+				}
+
+				if (callbackInterrupt &&
+					callbackInterrupt(m_socketRef)) {
+					throw general::SocketException(INTERRUPT_MSG);
+				}
+
+				co_await loop.waitFor(m_socketId, EVENT_READ);
+			}
+		}
+
+		Task<std::size_t> SocketDescriptor::asyncWrite(EventLoop& loop, const char* data, std::size_t dataSize)
+		{
+			const auto& callbackInterrupt = m_socketRef.m_callbackInterrupt;
+
+			std::size_t totalBytes = 0;
+			while (totalBytes < dataSize) {
+				const auto bufLen = static_cast<int>((std::min)(dataSize - totalBytes, static_cast<std::size_t>(INT_MAX)));
+				const auto sendBytes = send(m_socketId, data + totalBytes, bufLen, 0);
+				if (sendBytes != SOCKET_ERROR) {
+					totalBytes += static_cast<std::size_t>(sendBytes);
+					continue;
+				}
+
+				const auto lasterror = WSAGetLastError();
+				if (lasterror != WSAEWOULDBLOCK) {
+					throw general::SocketException(lasterror);
+				}
+
+				if (callbackInterrupt &&
+					callbackInterrupt(m_socketRef)) {
+					throw general::SocketException(INTERRUPT_MSG);
+				}
+
+				co_await loop.waitFor(m_socketId, EVENT_WRITE);
+			}
+
+			co_return totalBytes;
+		}
+#endif // SOCKET_COROUTINES_SUPPORTED
 	}
 }
\ No newline at end of file
@@ -72,26 +72,51 @@ typedef UINT_PTR SOCKET;
 #endif
 
 #include "SocketExport.h"
+#include "Task.h"
+#include "BufferPool.h"
+#include "RingBuffer.h"
 
 #include <vector>
 #include <string>
-
-#if (__cplusplus >= 201703L)
-#define NODISCARD [[nodiscard]]
-#else
-#define NODISCARD
-#endif
+#include <atomic>
+#include <cstdint>
+#include <chrono>
 
 namespace sdk {
 	namespace network {
 
 		class Socket; // forward declaration
+#if SOCKET_COROUTINES_SUPPORTED
+		class EventLoop; // forward declaration
+#endif
+
+		// a read only buffer of a gather write
+		struct ConstBuffer {
+			const char* data;
+			std::size_t size;
+		};
+
+		// a writable buffer of a scatter read
+		struct MutableBuffer {
+			char* data;
+			std::size_t size;
+		};
+
+		// a range of zero copy sends whose buffers may be reused
+		struct ZeroCopyCompletion {
+			std::uint32_t first; // sequence of the first send
+			std::uint32_t last;	 // sequence of the last send, inclusive
+			bool copied;		 // the kernel fell back to copying the data
+		};
 
 		/**
 		 * @brief This class is used for socket descriptor operations.
 		 *	You can read and write operations with this class.
 		 */
 		class SOCKET_API SocketDescriptor {
+			template <typename T>
+			friend class SocketOption;
+
 		public:
 			explicit SocketDescriptor(SOCKET socketId, const Socket& socketRef) noexcept;
 			virtual ~SocketDescriptor();
@@ -122,6 +147,59 @@ namespace sdk {
 			 */
 			NODISCARD virtual std::size_t read(std::string& message, int maxSize = 0) const;
 
+			/**
+			 * @brief This function reads directly into a caller owned buffer, no heap allocation
+			 * or intermediate copy is done. It waits for the first bytes up to the receive timeout,
+			 * then takes the bytes that are already available until the buffer is full.
+			 * @param buffer Destination buffer.
+			 * @param bufSize Size of destination buffer.
+			 * @return Return byte count that read, 0 if the timeout expired or the connection is closed.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD virtual std::size_t read(char* buffer, std::size_t bufSize) const;
+
+			/**
+			 * @brief This function reads like read(char*, std::size_t) but waits for the first bytes
+			 * until the deadline instead of the receive timeout.
+			 * @param buffer Destination buffer.
+			 * @param bufSize Size of destination buffer.
+			 * @param deadline The time after which the read gives up, a passed deadline only takes
+			 * the bytes that are already available.
+			 * @return Return byte count that read, 0 if the deadline expired or the connection is closed.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD std::size_t read(char* buffer, std::size_t bufSize, std::chrono::steady_clock::time_point deadline) const;
+
+			/**
+			 * @brief This function reads like read(std::string&, int) but waits for the first bytes
+			 * until the deadline instead of the receive timeout.
+			 * @param message the message that you want to read.
+			 * @param deadline The time after which the read gives up.
+			 * @param maxSize maximum size of the message.
+			 * @return Return byte count that read.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD std::size_t read(std::string& message, std::chrono::steady_clock::time_point deadline, int maxSize = 0) const;
+
+			/**
+			 * @brief This function reads into a buffer that is drawn from the pool. Hand the buffer
+			 * back by destroying it or calling release() after processing.
+			 * @param pool The pool that the buffer is drawn from.
+			 * @param maxSize maximum size of the message, 0 reads up to the buffer capacity.
+			 * @return The buffer, its size is the byte count that read.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD PooledBuffer read(BufferPool& pool, std::size_t maxSize = 0) const;
+
+			/**
+			 * @brief This function appends the received bytes to the free space of a ring buffer.
+			 * The bytes are consumed by the caller with RingBuffer::consume() after processing.
+			 * @param ring The ring buffer that receives the bytes.
+			 * @return Return byte count that read, 0 if the timeout expired or the connection is closed.
+			 * @exception this function throws an SocketException if an error occurs or the ring is full.
+			 */
+			NODISCARD std::size_t read(RingBuffer& ring) const;
+
 			/**
 			 * @brief This function used for reading operations from related socket.
 			 * @param dataList initializer_list of data via modern c++.
@@ -155,6 +233,92 @@ namespace sdk {
 			 */
 			NODISCARD virtual int write(const std::string& message);
 
+			/**
+			 * @brief This function writes the whole message. It waits for writability while the send
+			 * buffer is full and resumes partial sends until the message is sent or the timeout expires.
+			 * @param data Bytes of message.
+			 * @param dataSize Size of message.
+			 * @param timeout Maximum time to spend, a negative value waits until the message is sent.
+			 * On Windows a send on a blocking socket can still block past the timeout, set the socket
+			 * to non-blocking mode there if the timeout has to be kept.
+			 * @return Return byte count that write, less than dataSize if the timeout expired.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD virtual std::size_t writeAll(const char* data, std::size_t dataSize,
+				std::chrono::milliseconds timeout = std::chrono::milliseconds{ -1 });
+
+			/**
+			 * @brief This function writes the whole message like writeAll() with a timeout, but stops
+			 * at an absolute deadline, so several operations can share one deadline.
+			 * @param data Bytes of message.
+			 * @param dataSize Size of message.
+			 * @param deadline The time after which the write gives up.
+			 * @return Return byte count that write, less than dataSize if the deadline expired.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD std::size_t writeAll(const char* data, std::size_t dataSize, std::chrono::steady_clock::time_point deadline);
+
+			/**
+			 * @brief This function writes several buffers with a single system call (sendmsg/WSASend),
+			 * so separate header, body and trailer buffers do not have to be concatenated.
+			 * @param buffers Array of buffers, they are written in order.
+			 * @param count Count of buffers.
+			 * @return Return byte count that write, it may be less than the total size of buffers.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD virtual std::size_t gatherWrite(const ConstBuffer* buffers, std::size_t count);
+
+			/**
+			 * @brief This function reads into several buffers with a single system call (recvmsg/WSARecv).
+			 * The buffers are filled in order.
+			 * @param buffers Array of buffers.
+			 * @param count Count of buffers.
+			 * @return Return byte count that read, 0 if the timeout expired or the connection is closed.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD virtual std::size_t scatterRead(const MutableBuffer* buffers, std::size_t count) const;
+
+			/**
+			 * @brief This function sends a part of a file without copying it through user space
+			 * (sendfile). Platforms that lack it read the file in chunks and write them.
+			 * With a non-blocking socket it returns as soon as the socket is not writable,
+			 * call it again with the advanced offset when the socket is writable.
+			 * @param fileFd Descriptor of the file opened for reading.
+			 * @param offset File offset to start from, it is advanced by the byte count that sent.
+			 * @param length Byte count to send.
+			 * @return Return byte count that sent, less than length if the socket is not writable or
+			 * the end of file is reached.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD virtual std::size_t sendFile(int fileFd, std::int64_t& offset, std::size_t length);
+
+			/**
+			 * @brief This function sends the data without copying it into the kernel (MSG_ZEROCOPY).
+			 * The buffer must not be modified or freed until pollZeroCopyCompletions() reports
+			 * the sequence of the send. Enable SocketOption::setZeroCopy before the first send,
+			 * otherwise, and on platforms other than Linux, the data is copied and the send is
+			 * reported as completed immediately. If too many sends are not completed yet, it collects
+			 * the completions that the kernel reports and tries again, they are returned by the next
+			 * pollZeroCopyCompletions() call. It throws if the kernel refuses the send while no
+			 * completion is pending.
+			 * @param data Bytes of message.
+			 * @param dataSize Size of message.
+			 * @param sequence Sequence number of the send, it increases by one for each send.
+			 * @return Return byte count that write.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD virtual std::size_t writeZeroCopy(const char* data, std::size_t dataSize, std::uint32_t& sequence);
+
+			/**
+			 * @brief This function collects the completions of zero copy sends from the error queue
+			 * of the socket.
+			 * @param completions Completed sequence ranges are appended to it.
+			 * @param timeoutMs Wait timeout for the first completion in milliseconds, 0 does not wait.
+			 * @return Return count of the ranges that appended.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD std::size_t pollZeroCopyCompletions(std::vector<ZeroCopyCompletion>& completions, int timeoutMs = 0);
+
 			/**
 			 * @brief Gets a socket id from related socket.
 			 * @return The id of socket.
@@ -165,12 +329,140 @@ namespace sdk {
 				return m_socketId;
 			}
 
+#if SOCKET_COROUTINES_SUPPORTED
+			/**
+			 * @brief Reads available bytes from related socket. The coroutine is suspended on the loop
+			 * while no data is available. The socket must be in non-blocking mode and the descriptor must
+			 * outlive the returned task.
+			 * @param loop The event loop that resumes the coroutine.
+			 * @param buffer Destination buffer.
+			 * @param bufSize Size of destination buffer.
+			 * @return A task that yields the byte count that read, 0 if the peer closed the connection.
+			 * @exception the task throws an SocketException if an error occurs.
+			 */
+			NODISCARD Task<std::size_t> asyncRead(EventLoop& loop, char* buffer, std::size_t bufSize);
+
+			/**
+			 * @brief Writes all bytes to related socket. The coroutine is suspended on the loop
+			 * while the send buffer is full. The socket must be in non-blocking mode and the descriptor
+			 * and the data must outlive the returned task.
+			 * @param loop The event loop that resumes the coroutine.
+			 * @param data Bytes of message.
+			 * @param dataSize Size of message.
+			 * @return A task that yields the byte count that write.
+			 * @exception the task throws an SocketException if an error occurs.
+			 */
+			NODISCARD Task<std::size_t> asyncWrite(EventLoop& loop, const char* data, std::size_t dataSize);
+#endif // SOCKET_COROUTINES_SUPPORTED
+
 		protected:
 			[[nodiscard]] virtual std::string read(int maxSize = 0) const;
 
+			/**
+			 * @brief Receives into the buffer until it is full or no more data is available.
+			 * All read functions end up here, derived classes override it for their transport.
+			 * @param buffer Destination buffer.
+			 * @param bufSize Size of destination buffer.
+			 * @param timeoutMs Wait timeout for the first bytes in milliseconds.
+			 * @return Return byte count that read.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD virtual std::size_t readAvailable(char* buffer, std::size_t bufSize, int timeoutMs) const;
+
+			/**
+			 * @brief Waits until data can be read without blocking, so a blocking socket
+			 * does not block in the system call past a deadline.
+			 * @param timeoutMs Wait timeout in milliseconds.
+			 * @return true if data or an error is pending, false if the timeout expired.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD virtual bool waitReadable(int timeoutMs) const;
+
+			/**
+			 * @brief Gets the receive timeout of the socket in milliseconds, a default value is
+			 * returned if the timeout is not set. The socket is queried once, the value is cached
+			 * until it is changed with SocketOption::setRecvTimeout() on the descriptor or on its Socket.
+			 * @return The receive timeout in milliseconds.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD int getRecvTimeoutMs() const;
+
+			/**
+			 * @brief Sends a part of a file by reading it in chunks and writing them with write().
+			 * @param fileFd Descriptor of the file opened for reading.
+			 * @param offset File offset to start from, it is advanced by the byte count that sent.
+			 * @param length Byte count to send.
+			 * @return Return byte count that sent.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD std::size_t sendFileChunked(int fileFd, std::int64_t& offset, std::size_t length);
+
+			/**
+			 * @brief Gets the time left until a deadline.
+			 * @param deadline The deadline.
+			 * @return The remaining time in milliseconds rounded up, 0 if the deadline passed.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD static int getRemainingMs(std::chrono::steady_clock::time_point deadline) noexcept;
+
+			/**
+			 * @brief Gets how long a write may wait for writability before it checks the interrupt
+			 * callback and the deadline again.
+			 * @param deadline Deadline of the operation.
+			 * @param timeout Timeout of the operation, negative if there is no deadline.
+			 * @return The wait time in milliseconds, 0 if the deadline expired.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD static int getWaitSlice(std::chrono::steady_clock::time_point deadline,
+				std::chrono::milliseconds timeout) noexcept;
+
+			/**
+			 * @brief Sends the data with write() and numbers it like a zero copy send.
+			 * @param data Bytes of message.
+			 * @param dataSize Size of message.
+			 * @param sequence Sequence number of the send.
+			 * @return Return byte count that write.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD std::size_t writeCopied(const char* data, std::size_t dataSize, std::uint32_t& sequence);
+
+			/**
+			 * @brief Reads the zero copy completions from the error queue of the socket.
+			 * @param completions Completed sequence ranges are appended to it.
+			 * @param timeoutMs Wait timeout for the first completion in milliseconds, 0 does not wait.
+			 * @return Return count of the ranges that appended.
+			 * @exception this function throws an SocketException if an error occurs.
+			 */
+			NODISCARD std::size_t readZeroCopyCompletions(std::vector<ZeroCopyCompletion>& completions, int timeoutMs);
+
 			SOCKET m_socketId{ INVALID_SOCKET };
 			static constexpr int MAX_MESSAGE_SIZE = 8096;
 			const Socket& m_socketRef;
+
+		private:
+			enum class ZeroCopyState : std::uint8_t {
+				unknown = 0,
+				enabled,
+				disabled
+			};
+
+			static constexpr int RECV_TIMEOUT_UNKNOWN = -1;
+
+			mutable std::atomic<int> m_recvTimeoutMs{ RECV_TIMEOUT_UNKNOWN }; // cached receive timeout
+			mutable std::atomic<std::uint32_t> m_recvTimeoutVersion{};		  // timeout version of the Socket it is cached for
+			std::uint32_t m_zeroCopyNext{};		// sequence of the next zero copy send
+			std::uint32_t m_zeroCopyReported{}; // first copied send that is not reported yet
+			std::uint32_t m_zeroCopyDone{};		// count of zero copy sends whose completion is read
+			ZeroCopyState m_zeroCopyState{ ZeroCopyState::unknown };
+			std::vector<ZeroCopyCompletion> m_zeroCopyCompleted; // collected by a send that ran out of buffers
+
+			// reads into the unused tail of the container
+			template <typename Container>
+			void readAppend(Container& message, int maxSize, int timeoutMs) const;
+
+#if IO_URING_SUPPORTED
+			NODISCARD std::size_t readIoUring(char* buffer, std::size_t bufSize, int timeoutMs) const;
+#endif // IO_URING_SUPPORTED
 		};
 	}
 }
@@ -38,4 +38,11 @@
 #endif
 #endif
 
+/* Warns about ignored return values, C++17 and later */
+#if (__cplusplus >= 201703L)
+#define NODISCARD [[nodiscard]]
+#else
+#define NODISCARD
+#endif
+
 #endif // SOCKET_EXPORT_H
\ No newline at end of file
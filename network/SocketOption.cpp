@@ -25,6 +25,11 @@
 #include "SSLSocket.h"
 #include "SocketException.h"
 
+#ifndef _WIN32
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#endif
+
 namespace sdk {
 	namespace network {
 
@@ -48,6 +53,36 @@ namespace sdk {
 			}
 		}
 
+		template <typename T>
+		void SocketOption<T>::setReusePort(SocketOpt reuseMode)
+		{
+#ifdef SO_REUSEPORT
+			const auto mode = static_cast<int>(reuseMode);
+			if (setsockopt(m_socket.getSocketId(), SOL_SOCKET, SO_REUSEPORT,
+					reinterpret_cast<const char*>(&mode), sizeof(mode)) == SOCKET_ERROR) {
+				throw general::SocketException(WSAGetLastError());
+			}
+#else
+			(void)reuseMode;
+			throw general::SocketException("SO_REUSEPORT is not supported on this platform.");
+#endif
+		}
+
+		template <typename T>
+		void SocketOption<T>::setZeroCopy(SocketOpt zeroCopyMode)
+		{
+#ifdef SO_ZEROCOPY
+			const auto mode = static_cast<int>(zeroCopyMode);
+			if (setsockopt(m_socket.getSocketId(), SOL_SOCKET, SO_ZEROCOPY,
+					reinterpret_cast<const char*>(&mode), sizeof(mode)) == SOCKET_ERROR) {
+				throw general::SocketException(WSAGetLastError());
+			}
+#else
+			(void)zeroCopyMode;
+			throw general::SocketException("SO_ZEROCOPY is not supported on this platform.");
+#endif
+		}
+
 		template <typename T>
 		void SocketOption<T>::setKeepAlive(SocketOpt keepAliveMode)
 		{
@@ -58,6 +93,34 @@ namespace sdk {
 			}
 		}
 
+		template <typename T>
+		void SocketOption<T>::setDeferAccept(int seconds)
+		{
+#ifdef TCP_DEFER_ACCEPT
+			if (setsockopt(m_socket.getSocketId(), IPPROTO_TCP, TCP_DEFER_ACCEPT,
+					reinterpret_cast<const char*>(&seconds), sizeof(seconds)) == SOCKET_ERROR) {
+				throw general::SocketException(WSAGetLastError());
+			}
+#else
+			(void)seconds;
+			throw general::SocketException("TCP_DEFER_ACCEPT is not supported on this platform.");
+#endif
+		}
+
+		template <typename T>
+		void SocketOption<T>::setFastOpen(int queueLength)
+		{
+#ifdef TCP_FASTOPEN
+			if (setsockopt(m_socket.getSocketId(), IPPROTO_TCP, TCP_FASTOPEN,
+					reinterpret_cast<const char*>(&queueLength), sizeof(queueLength)) == SOCKET_ERROR) {
+				throw general::SocketException(WSAGetLastError());
+			}
+#else
+			(void)queueLength;
+			throw general::SocketException("TCP_FASTOPEN is not supported on this platform.");
+#endif
+		}
+
 		template <typename T>
 		void SocketOption<T>::setBlockingMode(SocketOpt blockingMode)
 		{
@@ -65,6 +128,7 @@ namespace sdk {
 			if (ioctlsocket(m_socket.getSocketId(), FIONBIO, &mode) == SOCKET_ERROR) {
 				throw general::SocketException(WSAGetLastError());
 			}
+			rememberBlockingMode(m_socket, blockingMode);
 		}
 
 		template <typename T>
@@ -89,6 +153,35 @@ namespace sdk {
 					reinterpret_cast<const char*>(&tVal), sizeof(tVal)) == SOCKET_ERROR) {
 				throw general::SocketException(WSAGetLastError());
 			}
+			resetRecvTimeout(m_socket);
+		}
+
+		template <typename T>
+		void SocketOption<T>::resetRecvTimeout(const Socket& socket) noexcept
+		{
+			// descriptors compare it with the version they cached the timeout for
+			socket.m_recvTimeoutVersion.fetch_add(1, std::memory_order_acq_rel);
+		}
+
+		template <typename T>
+		void SocketOption<T>::resetRecvTimeout(const SocketDescriptor& socketDesc) noexcept
+		{
+			socketDesc.m_recvTimeoutMs.store(SocketDescriptor::RECV_TIMEOUT_UNKNOWN, std::memory_order_release);
+		}
+
+		template <typename T>
+		void SocketOption<T>::rememberBlockingMode(const Socket& socket, SocketOpt blockingMode) noexcept
+		{
+			socket.m_nonBlocking = blockingMode == SocketOpt::ON;
+		}
+
+		template <typename T>
+		void SocketOption<T>::rememberBlockingMode(const SocketDescriptor& socketDesc, SocketOpt blockingMode) noexcept
+		{
+			// a client descriptor shares the socket of its Socket object
+			if (socketDesc.m_socketId == socketDesc.m_socketRef.m_socketId) {
+				socketDesc.m_socketRef.m_nonBlocking = blockingMode == SocketOpt::ON;
+			}
 		}
 
 		template <typename T>
@@ -131,6 +224,36 @@ namespace sdk {
 			return myOption;
 		}
 
+		template <typename T>
+		int SocketOption<T>::getReusePort() const
+		{
+			int myOption = 0;
+#ifdef SO_REUSEPORT
+			socklen_t myOptionLen = sizeof(myOption);
+
+			if (getsockopt(m_socket.getSocketId(), SOL_SOCKET, SO_REUSEPORT,
+					reinterpret_cast<char*>(&myOption), &myOptionLen) == SOCKET_ERROR) {
+				throw general::SocketException(WSAGetLastError());
+			}
+#endif
+			return myOption;
+		}
+
+		template <typename T>
+		int SocketOption<T>::getZeroCopy() const
+		{
+			int myOption = 0;
+#ifdef SO_ZEROCOPY
+			socklen_t myOptionLen = sizeof(myOption);
+
+			if (getsockopt(m_socket.getSocketId(), SOL_SOCKET, SO_ZEROCOPY,
+					reinterpret_cast<char*>(&myOption), &myOptionLen) == SOCKET_ERROR) {
+				throw general::SocketException(WSAGetLastError());
+			}
+#endif
+			return myOption;
+		}
+
 		template <typename T>
 		int SocketOption<T>::getKeepAlive() const
 		{
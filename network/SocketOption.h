@@ -36,6 +36,9 @@
 namespace sdk {
 	namespace network {
 
+		class Socket;			// forward declaration
+		class SocketDescriptor; // forward declaration
+
 		enum class SocketOpt : std::uint8_t {
 			OFF,
 			ON
@@ -50,6 +53,14 @@ namespace sdk {
 		private:
 			const T& m_socket;
 
+			// descriptors cache their receive timeout, the cache is dropped when it changes
+			static void resetRecvTimeout(const Socket& socket) noexcept;
+			static void resetRecvTimeout(const SocketDescriptor& socketDesc) noexcept;
+
+			// sockets remember their blocking mode, a replacing socket takes it over
+			static void rememberBlockingMode(const Socket& socket, SocketOpt blockingMode) noexcept;
+			static void rememberBlockingMode(const SocketDescriptor& socketDesc, SocketOpt blockingMode) noexcept;
+
 		public:
 			explicit SocketOption(const T& socket) :
 				m_socket{ socket }
@@ -76,6 +87,24 @@ namespace sdk {
 			 */
 			void setReuseAddr(SocketOpt reuseMode);
 
+			/**
+			 * @brief If you want several sockets to bind the same address and port, and let the kernel
+			 * load-balance incoming connections across them. It is not supported on Windows.
+			 * @param reuseMode Reuse port is active if 1, disabled 0.
+			 * @return nothing.
+			 * @exception This function throws an SocketException if an error occurs.
+			 */
+			void setReusePort(SocketOpt reuseMode);
+
+			/**
+			 * @brief Allows sends with MSG_ZEROCOPY on the socket, see SocketDescriptor::writeZeroCopy.
+			 * It is only supported on Linux 4.14 and later.
+			 * @param zeroCopyMode Zero copy is active if 1, disabled 0.
+			 * @return nothing.
+			 * @exception This function throws an SocketException if an error occurs.
+			 */
+			void setZeroCopy(SocketOpt zeroCopyMode);
+
 			/**
 			 * @brief Allow an application to enable keep-alive packets for a socket connection.
 			 * @param keepAliveMode Keep alive is active if 1, disabled 0.
@@ -84,6 +113,24 @@ namespace sdk {
 			 */
 			void setKeepAlive(SocketOpt keepAliveMode);
 
+			/**
+			 * @brief Lets a listening socket report a connection only when its first data arrives
+			 * (TCP_DEFER_ACCEPT). It is only supported on Linux.
+			 * @param seconds How long the kernel waits for the data, 0 disables it.
+			 * @return nothing.
+			 * @exception This function throws an SocketException if an error occurs.
+			 */
+			void setDeferAccept(int seconds);
+
+			/**
+			 * @brief Allows a listening socket to accept data in the SYN of a connection (TCP_FASTOPEN).
+			 * It must be set before listen().
+			 * @param queueLength Maximum count of pending fast open requests, 0 disables it.
+			 * @return nothing.
+			 * @exception This function throws an SocketException if an error occurs.
+			 */
+			void setFastOpen(int queueLength);
+
 			/**
 			 * @brief Enables or disables non-blocking mode on socket.
 			 * @param blockingMode Non-blocking mode is active if 1, disabled 0.
@@ -131,6 +178,20 @@ namespace sdk {
 			 */
 			[[nodiscard]] int getReuseAddr() const;
 
+			/**
+			 * @brief Gets reuse port state on socket.
+			 * @return Active if returns 1, disabled 0.
+			 * @exception This function throws an SocketException if an error occurs.
+			 */
+			[[nodiscard]] int getReusePort() const;
+
+			/**
+			 * @brief Gets zero copy state on socket.
+			 * @return Active if returns 1, disabled 0.
+			 * @exception This function throws an SocketException if an error occurs.
+			 */
+			[[nodiscard]] int getZeroCopy() const;
+
 			/**
 			 * @brief Gets keep alive state on socket.
 			 * @return Active if returns 1, disabled 0.
@@ -0,0 +1,196 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef TASK_H
+#define TASK_H
+
+// SOCKET_COROUTINES_SUPPORTED is defined by the build for C++20 builds, so that the library
+// and its users see the same declarations.
+#if SOCKET_COROUTINES_SUPPORTED
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace sdk {
+	namespace network {
+
+		template <typename T = void>
+		class Task;
+
+		namespace detail {
+
+			struct TaskPromiseBase {
+				struct FinalAwaiter {
+					bool await_ready() const noexcept
+					{
+						return false;
+					}
+
+					// resume the awaiting coroutine without growing the stack
+					template <typename Promise>
+					std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept
+					{
+						return handle.promise().m_continuation;
+					}
+
+					void await_resume() const noexcept {}
+				};
+
+				std::suspend_always initial_suspend() const noexcept
+				{
+					return {};
+				}
+
+				FinalAwaiter final_suspend() const noexcept
+				{
+					return {};
+				}
+
+				void unhandled_exception() noexcept
+				{
+					m_exception = std::current_exception();
+				}
+
+				std::coroutine_handle<> m_continuation{ std::noop_coroutine() };
+				std::exception_ptr m_exception;
+			};
+
+			template <typename T>
+			struct TaskPromise : TaskPromiseBase {
+				Task<T> get_return_object() noexcept;
+
+				template <typename U>
+				void return_value(U&& value)
+				{
+					m_value.emplace(std::forward<U>(value));
+				}
+
+				T result()
+				{
+					if (m_exception) {
+						std::rethrow_exception(m_exception);
+					}
+					return std::move(*m_value);
+				}
+
+				std::optional<T> m_value;
+			};
+
+			template <>
+			struct TaskPromise<void> : TaskPromiseBase {
+				Task<void> get_return_object() noexcept;
+
+				void return_void() const noexcept {}
+
+				void result() const
+				{
+					if (m_exception) {
+						std::rethrow_exception(m_exception);
+					}
+				}
+			};
+		}
+
+		/**
+		 * @brief Task class is a lazily started coroutine that produces a value of type T.
+		 * @details A task starts when it is awaited by another coroutine (co_await task) or
+		 *	when it is spawned on an EventLoop. The result or the exception of the coroutine
+		 *	is returned to the awaiting coroutine.
+		 */
+		template <typename T>
+		class Task {
+		public:
+			using promise_type = detail::TaskPromise<T>;
+
+			explicit Task(std::coroutine_handle<promise_type> handle) noexcept :
+				m_handle{ handle }
+			{
+			}
+
+			Task(Task&& other) noexcept :
+				m_handle{ std::exchange(other.m_handle, {}) }
+			{
+			}
+
+			Task& operator=(Task&& other) noexcept
+			{
+				if (this != &other) {
+					if (m_handle) {
+						m_handle.destroy();
+					}
+					m_handle = std::exchange(other.m_handle, {});
+				}
+				return *this;
+			}
+
+			~Task()
+			{
+				if (m_handle) {
+					m_handle.destroy();
+				}
+			}
+
+			// non copyable
+			Task(const Task&) = delete;
+			Task& operator=(const Task&) = delete;
+
+			bool await_ready() const noexcept
+			{
+				return !m_handle || m_handle.done();
+			}
+
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+			{
+				m_handle.promise().m_continuation = continuation;
+				return m_handle;
+			}
+
+			T await_resume()
+			{
+				return m_handle.promise().result();
+			}
+
+		private:
+			std::coroutine_handle<promise_type> m_handle;
+		};
+
+		namespace detail {
+
+			template <typename T>
+			Task<T> TaskPromise<T>::get_return_object() noexcept
+			{
+				return Task<T>{ std::coroutine_handle<TaskPromise<T>>::from_promise(*this) };
+			}
+
+			inline Task<void> TaskPromise<void>::get_return_object() noexcept
+			{
+				return Task<void>{ std::coroutine_handle<TaskPromise<void>>::from_promise(*this) };
+			}
+		}
+	}
+}
+
+#endif // SOCKET_COROUTINES_SUPPORTED
+
+#endif // TASK_H
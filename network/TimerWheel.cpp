@@ -0,0 +1,282 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace sdk {
+	namespace network {
+
+		// std::array::fill binds it to a reference, before C++17 it needs a definition
+		constexpr const std::uint32_t TimerWheel::NIL;
+
+		TimerWheel::TimerWheel(std::chrono::milliseconds resolution /*= std::chrono::milliseconds{ 10 }*/) noexcept :
+			m_start{ Clock::now() },
+			m_resolution{ (std::max)(resolution, std::chrono::milliseconds{ 1 }) }
+		{
+			m_lists.fill(NIL);
+		}
+
+		TimerId TimerWheel::schedule(std::chrono::milliseconds delay, TimerCallback callback)
+		{
+			std::uint32_t index = m_freeHead;
+			if (index != NIL) {
+				m_freeHead = m_nodes[index].next;
+			}
+			else {
+				index = static_cast<std::uint32_t>(m_nodes.size());
+				m_nodes.emplace_back();
+			}
+
+			auto& node = m_nodes[index];
+			node.callback = std::move(callback);
+			node.expiry = expiryOf(delay);
+			place(index);
+			++m_count;
+
+			return (static_cast<TimerId>(node.generation) << 32) | index;
+		}
+
+		bool TimerWheel::cancel(TimerId timerId) noexcept
+		{
+			const auto* node = findNode(timerId);
+			if (node == nullptr) {
+				return false;
+			}
+
+			const auto index = static_cast<std::uint32_t>(timerId);
+			unlink(index);
+			release(index);
+			return true;
+		}
+
+		bool TimerWheel::reschedule(TimerId timerId, std::chrono::milliseconds delay) noexcept
+		{
+			auto* node = findNode(timerId);
+			if (node == nullptr) {
+				return false;
+			}
+
+			const auto index = static_cast<std::uint32_t>(timerId);
+			unlink(index);
+			node->expiry = expiryOf(delay);
+			place(index);
+			return true;
+		}
+
+		std::size_t TimerWheel::advance()
+		{
+			return advance(Clock::now());
+		}
+
+		std::size_t TimerWheel::advance(Clock::time_point now)
+		{
+			const auto targetTick = toTick(now);
+			std::size_t fired = 0;
+
+			while (true) {
+				//	The expired timers are fired one by one from their own list, so a callback can
+				//	cancel the others and the rest is still fired if a callback throws.
+				while (m_lists[EXPIRED_LIST] != NIL) {
+					const auto index = m_lists[EXPIRED_LIST];
+					auto callback = std::move(m_nodes[index].callback);
+					unlink(index);
+					release(index);
+					++fired;
+					callback();
+				}
+
+				if (m_currentTick > targetTick) {
+					break;
+				}
+
+				if (m_count == 0) {
+					m_currentTick = targetTick + 1; // nothing to cascade or fire
+					break;
+				}
+
+				if ((m_currentTick & (SLOT_COUNT - 1)) == 0) {
+					cascade(1);
+				}
+
+				const auto slotList = static_cast<std::uint32_t>(m_currentTick & (SLOT_COUNT - 1));
+				while (m_lists[slotList] != NIL) {
+					const auto index = m_lists[slotList];
+					unlink(index);
+					link(EXPIRED_LIST, index);
+				}
+				++m_currentTick;
+			}
+
+			return fired;
+		}
+
+		int TimerWheel::getNextTimeoutMs() const noexcept
+		{
+			if (m_count == 0) {
+				return -1;
+			}
+
+			if (m_lists[EXPIRED_LIST] != NIL) {
+				return 0;
+			}
+
+			//	The next tick that fires a timer or cascades the upper levels,
+			//	the end of the current round of the lowest level at the latest.
+			auto dueTick = m_currentTick;
+			while ((dueTick & (SLOT_COUNT - 1)) != 0 && m_lists[dueTick & (SLOT_COUNT - 1)] == NIL) {
+				++dueTick;
+			}
+
+			const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - m_start).count();
+			const auto dueMs = static_cast<long long>(dueTick) * m_resolution.count();
+			if (dueMs <= elapsedMs) {
+				return 0;
+			}
+
+			return static_cast<int>((std::min)(dueMs - elapsedMs,
+				static_cast<long long>((std::numeric_limits<int>::max)())));
+		}
+
+		std::uint64_t TimerWheel::toTick(Clock::time_point timePoint) const noexcept
+		{
+			if (timePoint <= m_start) {
+				return 0;
+			}
+
+			const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(timePoint - m_start).count();
+			return static_cast<std::uint64_t>(elapsedMs / m_resolution.count());
+		}
+
+		std::uint64_t TimerWheel::expiryOf(std::chrono::milliseconds delay) const noexcept
+		{
+			const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - m_start).count();
+			const auto delayMs = (std::max)(delay.count(), static_cast<std::chrono::milliseconds::rep>(0));
+
+			// rounded up, so a timer never expires before its delay
+			const auto expiry = static_cast<std::uint64_t>((elapsedMs + delayMs + m_resolution.count() - 1) / m_resolution.count());
+			return (std::max)(expiry, m_currentTick);
+		}
+
+		TimerWheel::Node* TimerWheel::findNode(TimerId timerId) noexcept
+		{
+			const auto index = static_cast<std::uint32_t>(timerId);
+			const auto generation = static_cast<std::uint32_t>(timerId >> 32);
+			if (index >= m_nodes.size()) {
+				return nullptr;
+			}
+
+			auto& node = m_nodes[index];
+			if (node.list == NIL || node.generation != generation) {
+				return nullptr;
+			}
+			return &node;
+		}
+
+		void TimerWheel::place(std::uint32_t index) noexcept
+		{
+			const std::uint64_t wheelRange = 1ULL << (LEVEL_BITS * LEVEL_COUNT);
+
+			//	Timers beyond the range of the wheel wait on the highest level
+			//	and are placed again when their slot is cascaded.
+			auto tick = (std::max)(m_nodes[index].expiry, m_currentTick);
+			if (tick - m_currentTick >= wheelRange) {
+				tick = m_currentTick + wheelRange - 1;
+			}
+
+			const auto delta = tick - m_currentTick;
+			std::uint32_t level = 0;
+			while (level + 1 < LEVEL_COUNT && delta >= (1ULL << (LEVEL_BITS * (level + 1)))) {
+				++level;
+			}
+
+			const auto slot = static_cast<std::uint32_t>((tick >> (LEVEL_BITS * level)) & (SLOT_COUNT - 1));
+			link(level * SLOT_COUNT + slot, index);
+		}
+
+		void TimerWheel::link(std::uint32_t list, std::uint32_t index) noexcept
+		{
+			auto& node = m_nodes[index];
+			node.list = list;
+			node.prev = NIL;
+			node.next = m_lists[list];
+			if (node.next != NIL) {
+				m_nodes[node.next].prev = index;
+			}
+			m_lists[list] = index;
+		}
+
+		void TimerWheel::unlink(std::uint32_t index) noexcept
+		{
+			auto& node = m_nodes[index];
+			if (node.prev != NIL) {
+				m_nodes[node.prev].next = node.next;
+			}
+			else {
+				m_lists[node.list] = node.next;
+			}
+
+			if (node.next != NIL) {
+				m_nodes[node.next].prev = node.prev;
+			}
+		}
+
+		void TimerWheel::release(std::uint32_t index) noexcept
+		{
+			auto& node = m_nodes[index];
+			node.callback = nullptr;
+			node.list = NIL;
+			node.prev = NIL;
+			if (++node.generation == 0) {
+				node.generation = 1; // keeps the ids non zero
+			}
+
+			node.next = m_freeHead;
+			m_freeHead = index;
+			--m_count;
+		}
+
+		void TimerWheel::cascade(std::uint32_t level) noexcept
+		{
+			//	Called when the lower levels complete a round, the timers of the current
+			//	slot of this level are spread to the lower levels.
+			for (; level < LEVEL_COUNT; ++level) {
+				const auto slot = static_cast<std::uint32_t>((m_currentTick >> (LEVEL_BITS * level)) & (SLOT_COUNT - 1));
+				const auto list = level * SLOT_COUNT + slot;
+
+				auto index = m_lists[list];
+				m_lists[list] = NIL;
+				while (index != NIL) {
+					const auto next = m_nodes[index].next;
+					place(index);
+					index = next;
+				}
+
+				if (slot != 0) {
+					break; // the upper levels are not at the end of a round
+				}
+			}
+		}
+	}
+}
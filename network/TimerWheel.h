@@ -0,0 +1,169 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "SocketExport.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace sdk {
+	namespace network {
+
+		//	identifies a scheduled timer, 0 is never a valid id
+		using TimerId = std::uint64_t;
+
+		//	timer callback, invoked once when the timer expires
+		using TimerCallback = std::function<void()>;
+
+		/**
+		 * @brief TimerWheel class keeps a large number of timers with O(1) schedule and cancel.
+		 * @details The timers are kept in a hierarchical wheel of 4 levels with 64 slots each,
+		 *	a timer moves to a lower level when the time of its slot comes. Idle, read, write and
+		 *	handshake deadlines of many connections can be driven by one wheel instead of one
+		 *	sleeping wait per connection. The class is not thread safe, it is meant to be advanced
+		 *	by the thread that runs the reactor which owns it.
+		 */
+		class SOCKET_API TimerWheel {
+		public:
+			using Clock = std::chrono::steady_clock;
+
+			/**
+			 * @brief Creates an empty wheel.
+			 * @param resolution The duration of a tick, timers expire on tick boundaries.
+			 * @exception This function never throws an exception.
+			 */
+			explicit TimerWheel(std::chrono::milliseconds resolution = std::chrono::milliseconds{ 10 }) noexcept;
+			virtual ~TimerWheel() = default;
+
+			// non copyable
+			TimerWheel(const TimerWheel&) = delete;
+			TimerWheel& operator=(const TimerWheel&) = delete;
+
+			/**
+			 * @brief Schedules a timer.
+			 * @param delay The time after which the callback is invoked, it is rounded up to the resolution.
+			 * @param callback The function that is invoked by advance() when the timer expires.
+			 * @return The id of timer.
+			 * @exception This function may throw std::bad_alloc.
+			 */
+			TimerId schedule(std::chrono::milliseconds delay, TimerCallback callback);
+
+			/**
+			 * @brief Cancels a timer. Expired or already cancelled timers are ignored.
+			 * @param timerId The id of timer.
+			 * @return true if the timer was pending.
+			 * @exception This function never throws an exception.
+			 */
+			bool cancel(TimerId timerId) noexcept;
+
+			/**
+			 * @brief Moves the expiration of a pending timer, for example when an idle connection
+			 *	becomes active again. The callback is kept.
+			 * @param timerId The id of timer.
+			 * @param delay The new delay, counted from now.
+			 * @return true if the timer was pending.
+			 * @exception This function never throws an exception.
+			 */
+			bool reschedule(TimerId timerId, std::chrono::milliseconds delay) noexcept;
+
+			/**
+			 * @brief Invokes the callbacks of the timers that expired until now.
+			 * The callbacks may schedule and cancel timers.
+			 * @return The number of callbacks that were invoked.
+			 * @exception this function rethrows the exceptions of the callbacks.
+			 */
+			std::size_t advance();
+
+			/**
+			 * @brief Invokes the callbacks of the timers that expired until the given time.
+			 * @param now The current time.
+			 * @return The number of callbacks that were invoked.
+			 * @exception this function rethrows the exceptions of the callbacks.
+			 */
+			std::size_t advance(Clock::time_point now);
+
+			/**
+			 * @brief Gets how long a wait may last without missing a timer. The result may be
+			 *	earlier than the next expiration when the timers have to move to a lower level.
+			 * @return The timeout in milliseconds, -1 if there is no pending timer.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD int getNextTimeoutMs() const noexcept;
+
+			/**
+			 * @brief Gets the number of pending timers.
+			 * @return The number of pending timers.
+			 * @exception This function never throws an exception.
+			 */
+			NODISCARD std::size_t size() const noexcept
+			{
+				return m_count;
+			}
+
+			NODISCARD bool empty() const noexcept
+			{
+				return m_count == 0;
+			}
+
+		private:
+			static constexpr const std::uint32_t LEVEL_BITS = 6;
+			static constexpr const std::uint32_t SLOT_COUNT = 1U << LEVEL_BITS;
+			static constexpr const std::uint32_t LEVEL_COUNT = 4;
+			static constexpr const std::uint32_t EXPIRED_LIST = SLOT_COUNT * LEVEL_COUNT; // timers being fired
+			static constexpr const std::uint32_t NIL = 0xFFFFFFFFU;
+
+			struct Node {
+				TimerCallback callback;
+				std::uint64_t expiry{};
+				std::uint32_t prev{ NIL };
+				std::uint32_t next{ NIL };
+				std::uint32_t list{ NIL }; // NIL while the node is free
+				std::uint32_t generation{ 1 };
+			};
+
+			std::uint64_t toTick(Clock::time_point timePoint) const noexcept;
+			std::uint64_t expiryOf(std::chrono::milliseconds delay) const noexcept;
+			Node* findNode(TimerId timerId) noexcept;
+			void place(std::uint32_t index) noexcept;
+			void link(std::uint32_t list, std::uint32_t index) noexcept;
+			void unlink(std::uint32_t index) noexcept;
+			void release(std::uint32_t index) noexcept;
+			void cascade(std::uint32_t level) noexcept;
+
+			Clock::time_point m_start;
+			std::chrono::milliseconds m_resolution;
+			std::uint64_t m_currentTick{}; // the next tick to process
+			std::size_t m_count{};
+			std::vector<Node> m_nodes;
+			std::uint32_t m_freeHead{ NIL };
+			std::array<std::uint32_t, EXPIRED_LIST + 1> m_lists;
+		};
+	}
+}
+
+#endif // TIMER_WHEEL_H
@@ -0,0 +1,97 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include <network/Socket.h>
+#include <network/SocketOption.h>
+#include <network/SocketException.h>
+#include <network/Reactor.h>
+
+namespace {
+	const auto DEFAULT_LISTEN_PORT = 8091;
+	const auto DEFAULT_CLIENT = 64;
+	const auto CONNECTION_COUNT = 20;
+
+	bool TestAcceptBatch()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		serverOpt.setBlockingMode(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		// an empty backlog returns immediately
+		std::vector<SOCKET> socketIds;
+		if (server.acceptBatch(socketIds) != 0) {
+			return false;
+		}
+
+		std::vector<std::unique_ptr<sdk::network::Socket>> clients;
+		for (int i = 0; i < CONNECTION_COUNT; ++i) {
+			std::unique_ptr<sdk::network::Socket> client{ new sdk::network::Socket{ DEFAULT_LISTEN_PORT } };
+			client->setIpAddress("127.0.0.1");
+			client->connect();
+			clients.push_back(std::move(client));
+		}
+
+		if ((sdk::network::Reactor::waitFor(server.getSocketId(), sdk::network::EVENT_READ, 1000) & sdk::network::EVENT_READ) == 0) {
+			return false;
+		}
+
+		// the batch size bounds a call, the next calls drain the rest
+		bool success = server.acceptBatch(socketIds, 8) == 8;
+		while (success && server.acceptBatch(socketIds, 8) > 0) {
+		}
+		success = success && socketIds.size() == CONNECTION_COUNT;
+
+		// the accepted sockets are non-blocking
+		for (const auto socketId : socketIds) {
+			auto socketDesc = server.createSocketDescriptor(socketId);
+			char buffer{};
+			success = success && recv(socketId, &buffer, 1, 0) == SOCKET_ERROR && WSAGetLastError() == WSAEWOULDBLOCK;
+		}
+
+		return success;
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		success = TestAcceptBatch();
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
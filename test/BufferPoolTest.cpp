@@ -0,0 +1,134 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <network/BufferPool.h>
+
+namespace {
+	const std::size_t SMALL_CLASS = 2048;
+	const std::size_t LARGE_CLASS = 8192;
+	const auto THREAD_COUNT = 8;
+
+	// a request gets the smallest class that fits, larger ones are served by the heap
+	bool TestBufferClasses()
+	{
+		sdk::network::BufferPool pool{ { LARGE_CLASS, 0, SMALL_CLASS, SMALL_CLASS } };
+
+		auto small = pool.acquire(100);
+		auto large = pool.acquire(SMALL_CLASS + 1);
+		auto unpooled = pool.acquire(LARGE_CLASS + 1);
+		if (small.capacity() != SMALL_CLASS || large.capacity() != LARGE_CLASS ||
+			unpooled.capacity() != LARGE_CLASS + 1 || !small.empty()) {
+			return false;
+		}
+
+		small.setSize(SMALL_CLASS + 100);
+		if (small.size() != SMALL_CLASS) {
+			return false;
+		}
+
+		// the moved handle owns the buffer, the other one is empty
+		const char* data = small.data();
+		sdk::network::PooledBuffer moved{ std::move(small) };
+		if (moved.data() != data || small.data() != nullptr || small.capacity() != 0) {
+			return false;
+		}
+
+		unpooled.release();
+		return unpooled.data() == nullptr;
+	}
+
+	// a released buffer goes to the free list of the thread and it is reused first
+	bool TestThreadFreeList()
+	{
+		sdk::network::BufferPool pool{ { SMALL_CLASS } };
+
+		const char* data = nullptr;
+		{
+			auto buffer = pool.acquire(SMALL_CLASS);
+			data = buffer.data();
+		}
+		if (pool.acquire(SMALL_CLASS).data() != data) {
+			return false;
+		}
+
+		// a buffer released by a thread that never used the pool goes back to the pool
+		auto buffer = pool.acquire(SMALL_CLASS);
+		data = buffer.data();
+		const char* reused = nullptr;
+		std::thread other{ [&pool, &buffer, &reused]() {
+			buffer.release();
+			reused = pool.acquire(SMALL_CLASS).data();
+		} };
+		other.join();
+		return reused == data;
+	}
+
+	// the free lists of a finished thread go back to the pool, so the next thread needs no new memory
+	bool TestThreadExit()
+	{
+		sdk::network::BufferPool pool{ { SMALL_CLASS } };
+
+		std::vector<const char*> buffers;
+		for (int i = 0; i < THREAD_COUNT; ++i) {
+			std::thread worker{ [&pool, &buffers]() {
+				auto buffer = pool.acquire(SMALL_CLASS);
+				std::memset(buffer.data(), 0, buffer.capacity());
+				buffers.push_back(buffer.data());
+			} };
+			worker.join();
+		}
+
+		return std::all_of(buffers.begin(), buffers.end(), [&buffers](const char* data) {
+			return data == buffers.front();
+		});
+	}
+
+	// a buffer keeps its pool alive, and huge pages fall back to normal pages if none are reserved
+	bool TestHugePages()
+	{
+		sdk::network::PooledBuffer buffer;
+		{
+			sdk::network::BufferPool pool{ { LARGE_CLASS }, true };
+			buffer = pool.acquire(LARGE_CLASS);
+		}
+
+		if (buffer.data() == nullptr || buffer.capacity() != LARGE_CLASS) {
+			return false;
+		}
+		std::memset(buffer.data(), 1, buffer.capacity());
+		buffer.setSize(buffer.capacity());
+		buffer.release();
+		return buffer.data() == nullptr;
+	}
+}
+
+int main()
+{
+	const bool success = TestBufferClasses() && TestThreadFreeList() && TestThreadExit() && TestHugePages();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
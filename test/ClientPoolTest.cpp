@@ -0,0 +1,174 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <application/client/ClientPool.h>
+#include <network/Reactor.h>
+#include <network/Socket.h>
+#include <network/SocketOption.h>
+#include <network/SocketException.h>
+
+namespace {
+	const auto DEFAULT_LISTEN_PORT = 8096;
+	const auto DEFAULT_CLIENT = 10;
+	const std::string SERVER_ADDRESS{ "127.0.0.1" };
+
+	// a new connection of the pool is waiting in the backlog of the listener
+	bool HasNewConnection(const sdk::network::Socket& server)
+	{
+		return (sdk::network::Reactor::waitFor(server.getSocketId(), sdk::network::EVENT_READ, 1000) & sdk::network::EVENT_READ) != 0;
+	}
+
+	bool TestLeases(sdk::network::Socket& server)
+	{
+		sdk::application::ClientPoolConfig config;
+		config.maxIdle = 2;
+		config.idleTimeout = std::chrono::milliseconds(200);
+		sdk::application::ClientPool pool{ config };
+
+		// a lease that is given back is leased again without a new connection
+		std::shared_ptr<sdk::network::SocketDescriptor> serverDesc;
+		const sdk::application::Client* firstClient = nullptr;
+		{
+			auto lease = pool.acquire(SERVER_ADDRESS, DEFAULT_LISTEN_PORT);
+			if (!lease || !HasNewConnection(server)) {
+				return false;
+			}
+			serverDesc = server.createSocketDescriptor(server.accept());
+			firstClient = &*lease;
+		}
+		if (pool.getIdleCount(SERVER_ADDRESS, DEFAULT_LISTEN_PORT) != 1) {
+			return false;
+		}
+
+		{
+			auto lease = pool.acquire(SERVER_ADDRESS, DEFAULT_LISTEN_PORT);
+			if (&*lease != firstClient || pool.getIdleCount(SERVER_ADDRESS, DEFAULT_LISTEN_PORT) != 0) {
+				return false;
+			}
+		}
+
+		// a connection that the server closed is rejected and replaced
+		serverDesc.reset();
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		{
+			auto lease = pool.acquire(SERVER_ADDRESS, DEFAULT_LISTEN_PORT);
+			if (!lease || !lease->isAlive() || !HasNewConnection(server)) {
+				return false;
+			}
+			serverDesc = server.createSocketDescriptor(server.accept());
+		}
+
+		// the idle client is evicted after the idle timeout
+		if (pool.getIdleCount(SERVER_ADDRESS, DEFAULT_LISTEN_PORT) != 1) {
+			return false;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(250));
+		pool.evictIdle();
+		return pool.getIdleCount(SERVER_ADDRESS, DEFAULT_LISTEN_PORT) == 0;
+	}
+
+	// a client that closes slowly, like an SSLClient that waits for the close_notify of the server
+	class SlowClient : public sdk::application::Client {
+	public:
+		using Client::Client;
+		~SlowClient() override
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(300));
+		}
+	};
+
+	// the evicted clients are closed without holding the pool
+	bool TestEvictionOutsideLock(sdk::network::Socket& server)
+	{
+		sdk::application::ClientPoolConfig config;
+		config.idleTimeout = std::chrono::milliseconds(50);
+		sdk::application::ClientPool pool{ config, [](const std::string& ipAddr, int port) {
+			return std::unique_ptr<sdk::application::Client>(new SlowClient{ ipAddr, port });
+		} };
+
+		{
+			auto lease = pool.acquire(SERVER_ADDRESS, DEFAULT_LISTEN_PORT);
+			if (!HasNewConnection(server)) {
+				return false;
+			}
+			(void)server.createSocketDescriptor(server.accept());
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		std::thread evictor{ [&pool]() {
+			pool.evictIdle();
+		} };
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		const auto start = std::chrono::steady_clock::now();
+		const auto idleCount = pool.getIdleCount(SERVER_ADDRESS, DEFAULT_LISTEN_PORT);
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		evictor.join();
+		return idleCount == 0 && elapsed < std::chrono::milliseconds(100);
+	}
+
+	// a lease that outlives its pool closes its client
+	bool TestLeaseOutlivesPool(sdk::network::Socket& server)
+	{
+		sdk::application::PooledClient lease;
+		{
+			sdk::application::ClientPool pool;
+			lease = pool.acquire(SERVER_ADDRESS, DEFAULT_LISTEN_PORT);
+			if (!HasNewConnection(server)) {
+				return false;
+			}
+			(void)server.createSocketDescriptor(server.accept());
+		}
+		lease = sdk::application::PooledClient{};
+		return !lease;
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		success = TestLeases(server) && TestEvictionOutsideLock(server) && TestLeaseOutlivesPool(server);
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
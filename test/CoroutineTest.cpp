@@ -0,0 +1,154 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <network/Socket.h>
+#include <network/SocketOption.h>
+#include <network/SocketException.h>
+#include <network/EventLoop.h>
+
+namespace {
+	const auto DEFAULT_LISTEN_PORT = 8082;
+	const auto DEFAULT_CLIENT = 10;
+
+	sdk::network::Task<void> ServerTask(sdk::network::EventLoop& loop, sdk::network::Socket& server)
+	{
+		const auto clientId = co_await server.asyncAccept(loop);
+		sdk::network::SocketDescriptor descriptor{ clientId, server };
+		sdk::network::SocketOption<sdk::network::SocketDescriptor> descOpt{ descriptor };
+		descOpt.setBlockingMode(sdk::network::SocketOpt::ON);
+
+		char buffer[64]{};
+		const auto readBytes = co_await descriptor.asyncRead(loop, buffer, sizeof(buffer));
+		std::cout << "Message from client: " << std::string(buffer, readBytes) << "\r\n";
+		(void)co_await descriptor.asyncWrite(loop, "OK", 2);
+	}
+
+	sdk::network::Task<void> ClientTask(sdk::network::EventLoop& loop, std::string& response)
+	{
+		sdk::network::Socket clientSocket{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> clientOpt{ clientSocket };
+		clientOpt.setBlockingMode(sdk::network::SocketOpt::ON);
+		clientSocket.setIpAddress("127.0.0.1");
+		co_await clientSocket.asyncConnect(loop);
+
+		// the descriptor closes the socket id, so it must not outlive the client socket
+		auto socketDesc = std::make_unique<sdk::network::SocketDescriptor>(clientSocket.getSocketId(), clientSocket);
+		const std::string message{ "Hello from client!" };
+		(void)co_await socketDesc->asyncWrite(loop, message.data(), message.size());
+
+		char buffer[64]{};
+		std::size_t readBytes = 0;
+		while (readBytes < 2) {
+			const auto count = co_await socketDesc->asyncRead(loop, buffer + readBytes, sizeof(buffer) - readBytes);
+			if (count == 0) {
+				break;
+			}
+			readBytes += count;
+		}
+		response.assign(buffer, readBytes);
+	}
+
+	bool TestEchoServer()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		serverOpt.setBlockingMode(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		std::string response;
+		sdk::network::EventLoop loop;
+		loop.spawn(ServerTask(loop, server));
+		loop.spawn(ClientTask(loop, response));
+		loop.run(); // returns when both tasks complete
+
+		std::cout << "Response from server: " << response << "\r\n";
+		return response == "OK";
+	}
+
+	struct DestroyCounter {
+		int& count;
+
+		~DestroyCounter()
+		{
+			++count;
+		}
+	};
+
+	sdk::network::Task<void> IdleTask(sdk::network::EventLoop& loop, SOCKET socketId, int& destroyed, bool& resumed)
+	{
+		DestroyCounter counter{ destroyed };
+		(void)co_await loop.waitFor(socketId, sdk::network::EVENT_READ);
+		resumed = true;
+	}
+
+	sdk::network::Task<void> ParentTask(sdk::network::EventLoop& loop, SOCKET socketId, int& destroyed, bool& resumed)
+	{
+		DestroyCounter counter{ destroyed };
+		co_await IdleTask(loop, socketId, destroyed, resumed);
+		resumed = true;
+	}
+
+	// the frames of a task that still waits are released with the loop, together with the task it awaits
+	bool TestDestroySuspended()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		int destroyed = 0;
+		bool resumed = false;
+		{
+			sdk::network::EventLoop loop;
+			loop.spawn(ParentTask(loop, server.getSocketId(), destroyed, resumed));
+			if (destroyed != 0) {
+				return false;
+			}
+		}
+		return destroyed == 2 && !resumed;
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		success = TestEchoServer() && TestDestroySuspended();
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,189 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <network/Socket.h>
+#include <network/SocketException.h>
+#include <network/DatagramDescriptor.h>
+
+namespace {
+	const auto DEFAULT_LISTEN_PORT = 8086;
+	const auto DATAGRAM_COUNT = 100;
+
+	bool TestPeerAddress()
+	{
+		const sdk::network::PeerAddress ipv4{ "127.0.0.1", DEFAULT_LISTEN_PORT };
+		const sdk::network::PeerAddress ipv6{ "::1", DEFAULT_LISTEN_PORT };
+		return ipv4.getIpAddress() == "127.0.0.1" && ipv4.getPort() == DEFAULT_LISTEN_PORT &&
+			ipv6.getIpAddress() == "::1" && ipv6.getPort() == DEFAULT_LISTEN_PORT;
+	}
+
+	bool TestEchoBatch()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT, sdk::network::ProtocolType::udp };
+		server.bind();
+		sdk::network::Socket client{ DEFAULT_LISTEN_PORT, sdk::network::ProtocolType::udp };
+
+		sdk::network::DatagramDescriptor serverDatagrams{ server };
+		sdk::network::DatagramDescriptor clientDatagrams{ client };
+
+		// the client sends a batch of numbered datagrams
+		const sdk::network::PeerAddress serverAddress{ "127.0.0.1", DEFAULT_LISTEN_PORT };
+		std::vector<sdk::network::Datagram> requests(DATAGRAM_COUNT);
+		for (int index = 0; index < DATAGRAM_COUNT; ++index) {
+			const auto text = std::to_string(index);
+			requests[index].payload = sdk::network::BufferPool::defaultPool().acquire(text.size());
+			std::memcpy(requests[index].payload.data(), text.data(), text.size());
+			requests[index].payload.setSize(text.size());
+			requests[index].peer = serverAddress;
+		}
+		clientDatagrams.sendBatch(requests.data(), requests.size());
+
+		// the server echoes them back in batches to the addresses that they come from
+		std::vector<sdk::network::Datagram> received;
+		while (received.size() < DATAGRAM_COUNT) {
+			if (serverDatagrams.receiveBatch(received, DATAGRAM_COUNT, std::chrono::milliseconds{ 1000 }) == 0) {
+				return false;
+			}
+		}
+		serverDatagrams.sendBatch(received.data(), received.size());
+
+		std::vector<sdk::network::Datagram> replies;
+		std::size_t batchCount = 0;
+		while (replies.size() < DATAGRAM_COUNT) {
+			if (clientDatagrams.receiveBatch(replies, DATAGRAM_COUNT, std::chrono::milliseconds{ 1000 }) == 0) {
+				return false;
+			}
+			++batchCount;
+		}
+
+		std::cout << "Datagrams: " << replies.size() << " in " << batchCount << " batches from "
+			<< replies.front().peer.getIpAddress() << ":" << replies.front().peer.getPort() << "\r\n";
+
+		for (int index = 0; index < DATAGRAM_COUNT; ++index) {
+			const auto& payload = replies[index].payload;
+			if (std::string(payload.data(), payload.size()) != std::to_string(index) ||
+				replies[index].peer.getPort() != DEFAULT_LISTEN_PORT) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool TestSegmentation()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT, sdk::network::ProtocolType::udp };
+		server.bind();
+		sdk::network::Socket client{ DEFAULT_LISTEN_PORT, sdk::network::ProtocolType::udp };
+
+		sdk::network::DatagramDescriptor serverDatagrams{ server };
+		sdk::network::DatagramDescriptor clientDatagrams{ client };
+		const bool groEnabled = serverDatagrams.enableGro();
+
+		// every segment is filled with its own index
+		const std::size_t segmentSize = 1000;
+		std::string data;
+		for (int index = 0; index < 20; ++index) {
+			data.append(segmentSize, static_cast<char>('a' + index));
+		}
+		data.append(500, 'z');
+		clientDatagrams.sendSegmented(data.data(), data.size(), segmentSize, { "127.0.0.1", DEFAULT_LISTEN_PORT });
+
+		std::vector<sdk::network::Datagram> received;
+		std::vector<sdk::network::ConstBuffer> segments;
+		std::size_t receivedSize = 0;
+		while (receivedSize < data.size()) {
+			const auto firstIndex = received.size();
+			if (serverDatagrams.receiveBatch(received, sdk::network::DatagramDescriptor::MAX_BATCH_SIZE, std::chrono::milliseconds{ 1000 }) == 0) {
+				return false;
+			}
+
+			for (auto index = firstIndex; index < received.size(); ++index) {
+				(void)sdk::network::DatagramDescriptor::splitSegments(received[index], segments);
+				receivedSize += received[index].payload.size();
+			}
+		}
+
+		std::cout << "Segments: " << segments.size() << " in " << received.size() << " payloads, gro: " << groEnabled << "\r\n";
+
+		std::string joined;
+		for (const auto& segment : segments) {
+			if (segment.size != segmentSize && segment.data[0] != 'z') {
+				return false;
+			}
+			joined.append(segment.data, segment.size);
+		}
+		return segments.size() == 21 && joined == data;
+	}
+
+	// a datagram larger than the receive buffer is cut and flagged
+	bool TestTruncation()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT, sdk::network::ProtocolType::udp };
+		server.bind();
+		sdk::network::Socket client{ DEFAULT_LISTEN_PORT, sdk::network::ProtocolType::udp };
+
+		const std::size_t maxDatagramSize = 100;
+		sdk::network::DatagramDescriptor serverDatagrams{ server, sdk::network::BufferPool::defaultPool(), maxDatagramSize };
+		sdk::network::DatagramDescriptor clientDatagrams{ client };
+
+		const sdk::network::PeerAddress serverAddress{ "127.0.0.1", DEFAULT_LISTEN_PORT };
+		const std::string large(3 * maxDatagramSize, 'l');
+		const std::string small(maxDatagramSize / 2, 's');
+		clientDatagrams.sendTo(large.data(), large.size(), serverAddress);
+		clientDatagrams.sendTo(small.data(), small.size(), serverAddress);
+
+		std::vector<sdk::network::Datagram> received;
+		while (received.size() < 2) {
+			if (serverDatagrams.receiveBatch(received, 2, std::chrono::milliseconds{ 1000 }) == 0) {
+				return false;
+			}
+		}
+
+		const auto& cut = received[0];
+		const auto& whole = received[1];
+		return cut.truncated && std::string(cut.payload.data(), cut.payload.size()) == large.substr(0, maxDatagramSize) &&
+			!whole.truncated && std::string(whole.payload.data(), whole.payload.size()) == small;
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		success = TestPeerAddress() && TestEchoBatch() && TestSegmentation() && TestTruncation();
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
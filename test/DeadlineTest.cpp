@@ -0,0 +1,192 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <thread>
+#include <chrono>
+#include <climits>
+#include <string>
+#include <network/Socket.h>
+#include <network/SocketOption.h>
+#include <network/SocketException.h>
+
+namespace {
+	const auto DEFAULT_LISTEN_PORT = 8090;
+	const auto DEFAULT_CLIENT = 10;
+	const std::size_t READ_CHUNK_SIZE = 8095; // a read of unknown size receives it at once
+
+	using Clock = std::chrono::steady_clock;
+
+	bool TestDeadlines()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		sdk::network::Socket client{ DEFAULT_LISTEN_PORT };
+		client.setIpAddress("127.0.0.1");
+		client.connect();
+		auto clientDesc = client.createSocketDescriptor(client.getSocketId());
+
+		// the accepted socket is blocking, the deadline must still end the wait
+		auto serverDesc = server.createSocketDescriptor(server.accept());
+		char buffer[64];
+		auto start = Clock::now();
+		if (serverDesc->read(buffer, sizeof(buffer), start + std::chrono::milliseconds(100)) != 0 ||
+			Clock::now() - start < std::chrono::milliseconds(100) || Clock::now() - start > std::chrono::seconds(2)) {
+			return false;
+		}
+
+		const std::string message{ "deadline" };
+		if (clientDesc->writeAll(message.data(), message.size(), Clock::now() + std::chrono::seconds(1)) != message.size()) {
+			return false;
+		}
+
+		std::string received;
+		if (serverDesc->read(received, Clock::now() + std::chrono::seconds(1)) != message.size() || received != message) {
+			return false;
+		}
+
+		// the cached receive timeout follows the option of the descriptor
+		sdk::network::SocketOption<sdk::network::SocketDescriptor> descOpt{ *serverDesc };
+		descOpt.setBlockingMode(sdk::network::SocketOpt::ON);
+		descOpt.setRecvTimeout(0, 50000);
+		if (serverDesc->read(received) != 0) {
+			return false;
+		}
+
+		descOpt.setRecvTimeout(0, 300000);
+		start = Clock::now();
+		return serverDesc->read(received) == 0 && Clock::now() - start >= std::chrono::milliseconds(300);
+	}
+
+	// a timeout set through the Socket must drop the timeout cached by its descriptor
+	bool TestSocketRecvTimeout()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		sdk::network::Socket client{ DEFAULT_LISTEN_PORT };
+		client.setIpAddress("127.0.0.1");
+		client.connect();
+		auto clientDesc = client.createSocketDescriptor(client.getSocketId());
+		auto serverDesc = server.createSocketDescriptor(server.accept());
+
+		sdk::network::SocketOption<sdk::network::SocketDescriptor> descOpt{ *clientDesc };
+		descOpt.setBlockingMode(sdk::network::SocketOpt::ON);
+		descOpt.setRecvTimeout(0, 50000);
+		std::string received;
+		if (clientDesc->read(received) != 0) {
+			return false;
+		}
+
+		sdk::network::SocketOption<sdk::network::Socket> clientOpt{ client };
+		clientOpt.setRecvTimeout(0, 300000);
+		const auto start = Clock::now();
+		return clientDesc->read(received) == 0 && Clock::now() - start >= std::chrono::milliseconds(300);
+	}
+
+	// a message of whole read chunks must not block a blocking socket for the next chunk
+	bool TestWholeChunks()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		sdk::network::Socket client{ DEFAULT_LISTEN_PORT };
+		client.setIpAddress("127.0.0.1");
+		client.connect();
+		auto clientDesc = client.createSocketDescriptor(client.getSocketId());
+		auto serverDesc = server.createSocketDescriptor(server.accept());
+
+		const std::string message(2 * READ_CHUNK_SIZE, 'x');
+		for (int i = 0; i < 2; ++i) {
+			if (clientDesc->writeAll(message.data(), message.size(), Clock::now() + std::chrono::seconds(1)) != message.size()) {
+				return false;
+			}
+
+			// the whole message is already received, so the read must not wait for the closing peer
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			std::string received;
+			const auto start = Clock::now();
+			const auto readBytes = i == 0 ? serverDesc->read(received) : serverDesc->read(received, INT_MAX);
+			if (readBytes != message.size() || Clock::now() - start > std::chrono::milliseconds(500)) {
+				return false;
+			}
+
+			// a huge maxSize grows the message by chunks, it is not allocated at once
+			if (received.capacity() > 4 * message.size()) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// a peer that does not read fills the send buffer, the timeout must end the write on a blocking socket
+	bool TestWriteTimeout()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		sdk::network::Socket client{ DEFAULT_LISTEN_PORT };
+		client.setIpAddress("127.0.0.1");
+		client.connect();
+		auto clientDesc = client.createSocketDescriptor(client.getSocketId());
+		auto serverDesc = server.createSocketDescriptor(server.accept());
+
+		const std::string message(64 * 1024 * 1024, 'x');
+		const auto start = Clock::now();
+		const auto sendBytes = clientDesc->writeAll(message.data(), message.size(), std::chrono::milliseconds(200));
+		const auto elapsed = Clock::now() - start;
+		return sendBytes > 0 && sendBytes < message.size() &&
+			elapsed >= std::chrono::milliseconds(200) && elapsed < std::chrono::seconds(2);
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		success = TestDeadlines() && TestSocketRecvTimeout() && TestWholeChunks() && TestWriteTimeout();
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,125 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <network/Socket.h>
+#include <network/SocketOption.h>
+#include <network/SocketException.h>
+#include <network/FrameCodec.h>
+
+namespace {
+	const auto DEFAULT_LISTEN_PORT = 8083;
+	const auto DEFAULT_CLIENT = 10;
+
+	bool TestLengthEncoding()
+	{
+		using sdk::network::ByteOrder;
+		using sdk::network::FrameCodec;
+		using sdk::network::FramePrefix;
+
+		char prefix[8]{};
+		FrameCodec::encodeLength(0x0102, FramePrefix::twoBytes, ByteOrder::bigEndian, prefix);
+		if (prefix[0] != 0x01 || prefix[1] != 0x02) {
+			return false;
+		}
+
+		FrameCodec::encodeLength(0x0102, FramePrefix::fourBytes, ByteOrder::littleEndian, prefix);
+		if (prefix[0] != 0x02 || prefix[1] != 0x01 || prefix[2] != 0 || prefix[3] != 0) {
+			return false;
+		}
+
+		FrameCodec::encodeLength(0x0102030405060708ULL, FramePrefix::eightBytes, ByteOrder::bigEndian, prefix);
+		return FrameCodec::decodeLength(prefix, FramePrefix::eightBytes, ByteOrder::bigEndian) == 0x0102030405060708ULL;
+	}
+
+	bool TestFramesOverSocket()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		std::thread client{ []() {
+			try {
+				sdk::network::Socket clientSocket{ DEFAULT_LISTEN_PORT };
+				clientSocket.setIpAddress("127.0.0.1");
+				clientSocket.connect();
+				auto socketDesc = clientSocket.createSocketDescriptor(clientSocket.getSocketId());
+				sdk::network::FrameCodec codec{ *socketDesc, sdk::network::FramePrefix::twoBytes };
+
+				// two frames in a single segment
+				codec.writeFrame("first");
+				codec.writeFrame("");
+
+				// a frame that is split across segments
+				const std::string raw{ "\x00\x06split!", 8 };
+				(void)socketDesc->write(raw.data(), 3);
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+				(void)socketDesc->write(raw.data() + 3, 5);
+
+				codec.writeFrame(std::string(100000, 'x'));
+			}
+			catch (const sdk::general::SocketException& err) {
+				std::cout << err.getErrorMsg() << "\r\n";
+			}
+		} };
+
+		auto serverDescriptor = server.createSocketDescriptor(server.accept());
+		sdk::network::FrameCodec codec{ *serverDescriptor, sdk::network::FramePrefix::twoBytes };
+
+		std::string first;
+		std::string empty{ "not empty" };
+		std::string split;
+		std::string large;
+		bool success = codec.readFrame(first) && codec.readFrame(empty) && codec.readFrame(split);
+		client.join();
+
+		// the last frame is larger than the two byte prefix allows, so it is never sent
+		success = success && !codec.readFrame(large);
+
+		std::cout << "Frames: " << first << ", " << empty.size() << ", " << split << "\r\n";
+		return success && first == "first" && empty.empty() && split == "split!" && codec.getBufferedSize() == 0;
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		success = TestLengthEncoding() && TestFramesOverSocket();
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
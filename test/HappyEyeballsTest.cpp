@@ -0,0 +1,169 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <network/Socket.h>
+#include <network/SocketOption.h>
+#include <network/SocketException.h>
+
+namespace {
+	const auto DEFAULT_LISTEN_PORT = 8088;
+	const auto CLOSED_PORT = 8089;
+	const auto DEFAULT_CLIENT = 10;
+	const auto RECV_BUFFER_SIZE = 32 * 1024;
+
+	bool TestRacingConnect()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		std::string message;
+		std::thread client{ []() {
+			try {
+				sdk::network::Socket clientSocket{ DEFAULT_LISTEN_PORT };
+				clientSocket.setIpAddress("localhost");
+				clientSocket.setHappyEyeballs(true);
+
+				const auto start = std::chrono::steady_clock::now();
+				clientSocket.connect();
+				const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+				std::cout << "Connected over IPv" << (clientSocket.getIpVersion() == sdk::network::IpVersion::IPv6 ? 6 : 4)
+					<< " in " << elapsed.count() << " ms\r\n";
+
+				// the adopted socket is the one that descriptors use
+				auto socketDesc = clientSocket.createSocketDescriptor(clientSocket.getSocketId());
+				(void)socketDesc->write("raced");
+			}
+			catch (const sdk::general::SocketException& err) {
+				std::cout << err.getErrorMsg() << "\r\n";
+			}
+		} };
+
+		auto serverDescriptor = server.createSocketDescriptor(server.accept());
+		(void)serverDescriptor->read(message);
+		client.join();
+		return message == "raced";
+	}
+
+	// the winner takes over the blocking mode, a bound socket keeps its local address
+	bool TestSocketState()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		sdk::network::Socket nonBlockingClient{ DEFAULT_LISTEN_PORT };
+		nonBlockingClient.setIpAddress("localhost");
+		nonBlockingClient.setHappyEyeballs(true);
+		sdk::network::SocketOption<sdk::network::Socket> clientOpt{ nonBlockingClient };
+		clientOpt.setBlockingMode(sdk::network::SocketOpt::ON);
+		clientOpt.setKeepAlive(sdk::network::SocketOpt::ON);
+#ifdef SO_ZEROCOPY
+		clientOpt.setZeroCopy(sdk::network::SocketOpt::ON);
+#endif
+		int bufferSize = RECV_BUFFER_SIZE;
+		(void)setsockopt(nonBlockingClient.getSocketId(), SOL_SOCKET, SO_RCVBUF,
+			reinterpret_cast<const char*>(&bufferSize), sizeof(bufferSize));
+		socklen_t bufferSizeSize = sizeof(bufferSize);
+		(void)getsockopt(nonBlockingClient.getSocketId(), SOL_SOCKET, SO_RCVBUF, reinterpret_cast<char*>(&bufferSize), &bufferSizeSize);
+		const int setBufferSize = bufferSize;
+		nonBlockingClient.connect();
+
+		char byte{};
+		if (recv(nonBlockingClient.getSocketId(), &byte, 1, 0) != SOCKET_ERROR || WSAGetLastError() != WSAEWOULDBLOCK) {
+			return false;
+		}
+
+		// the options set before the connect are kept by the winning attempt
+		bufferSize = 0;
+		(void)getsockopt(nonBlockingClient.getSocketId(), SOL_SOCKET, SO_RCVBUF, reinterpret_cast<char*>(&bufferSize), &bufferSizeSize);
+		if (clientOpt.getKeepAlive() == 0 || bufferSize != setBufferSize) {
+			return false;
+		}
+#ifdef SO_ZEROCOPY
+		if (clientOpt.getZeroCopy() == 0) {
+			return false;
+		}
+#endif
+
+		sdk::network::Socket boundClient{ DEFAULT_LISTEN_PORT };
+		boundClient.setIpAddress("localhost");
+		boundClient.setHappyEyeballs(true);
+		sockaddr_in local{};
+		local.sin_family = AF_INET;
+		local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		socklen_t localSize = sizeof(local);
+		if (::bind(boundClient.getSocketId(), reinterpret_cast<const sockaddr*>(&local), sizeof(local)) == SOCKET_ERROR ||
+			getsockname(boundClient.getSocketId(), reinterpret_cast<sockaddr*>(&local), &localSize) == SOCKET_ERROR) {
+			return false;
+		}
+
+		const auto boundSocket = boundClient.getSocketId();
+		boundClient.connect();
+		sockaddr_in connected{};
+		socklen_t connectedSize = sizeof(connected);
+		return boundClient.getSocketId() == boundSocket &&
+			getsockname(boundClient.getSocketId(), reinterpret_cast<sockaddr*>(&connected), &connectedSize) != SOCKET_ERROR &&
+			connected.sin_port == local.sin_port;
+	}
+
+	bool TestAllAttemptsFail()
+	{
+		sdk::network::Socket clientSocket{ CLOSED_PORT };
+		clientSocket.setIpAddress("localhost");
+		clientSocket.setHappyEyeballs(true);
+		try {
+			clientSocket.connect();
+		}
+		catch (const sdk::general::SocketException&) {
+			return true;
+		}
+		return false;
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		success = TestRacingConnect() && TestSocketState() && TestAllAttemptsFail();
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,180 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <network/Socket.h>
+#include <network/SocketOption.h>
+#include <network/SocketException.h>
+#include <network/IoUring.h>
+#include <network/CancellationToken.h>
+
+namespace {
+	const auto DEFAULT_LISTEN_PORT = 8092;
+	const auto DEFAULT_CLIENT = 8;
+	const auto CONNECTION_COUNT = 3;
+
+	sdk::network::IoEngine ExpectedEngine()
+	{
+#if IO_URING_SUPPORTED
+		if (sdk::network::IoUring::isSupported()) {
+			return sdk::network::IoEngine::ioUring;
+		}
+#endif
+		return sdk::network::IoEngine::poll;
+	}
+
+	std::unique_ptr<sdk::network::Socket> CreateListener()
+	{
+		std::unique_ptr<sdk::network::Socket> server{ new sdk::network::Socket{ DEFAULT_LISTEN_PORT } };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ *server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server->bind();
+		server->listen(DEFAULT_CLIENT);
+		return server;
+	}
+
+	/*
+	*	The engine falls back to poll if io_uring is not available, the requests behave the same on both.
+	*	Each connection is accepted by a multishot request or, on older kernels, by a new single shot one.
+	*	The accept is armed on the ring of a thread that outlives the listener, closing the listener on
+	*	another thread must still release the port.
+	*/
+	bool TestEngine()
+	{
+		auto server = CreateListener();
+		if (server->setIoEngine(sdk::network::IoEngine::ioUring) != ExpectedEngine()) {
+			return false;
+		}
+
+		std::mutex lock;
+		std::condition_variable cv;
+		bool released = false;
+		int received = 0;
+
+		std::thread acceptor{ [&]() {
+			try {
+				for (int i = 0; i < CONNECTION_COUNT; ++i) {
+					const auto socketId = server->accept();
+					auto serverDesc = server->createSocketDescriptor(socketId);
+					std::string message;
+					if (serverDesc->read(message) > 0 && message == "Hello from client!") {
+						++received;
+						(void)serverDesc->write("OK");
+					}
+				}
+			}
+			catch (const sdk::general::SocketException& err) {
+				std::cout << err.getErrorMsg() << "\r\n";
+			}
+
+			// keep the ring of this thread alive until the listener is closed
+			std::unique_lock<std::mutex> guard(lock);
+			cv.wait(guard, [&released]() { return released; });
+		} };
+
+		int responses = 0;
+		for (int i = 0; i < CONNECTION_COUNT; ++i) {
+			sdk::network::Socket client{ DEFAULT_LISTEN_PORT };
+			client.setIpAddress("127.0.0.1");
+			client.setIoEngine(sdk::network::IoEngine::ioUring);
+			client.connect();
+			auto clientDesc = client.createSocketDescriptor(client.getSocketId());
+			std::string response;
+			if (clientDesc->write("Hello from client!") > 0 && clientDesc->read(response) > 0 && response == "OK") {
+				++responses;
+			}
+		}
+
+		bool success = responses == CONNECTION_COUNT;
+
+		// the listener is closed on this thread, the port is in use as long as an accept request holds it
+		server.reset();
+		try {
+			auto newServer = CreateListener();
+		}
+		catch (const sdk::general::SocketException& err) {
+			std::cout << err.getErrorMsg() << "\r\n";
+			success = false;
+		}
+
+		{
+			std::lock_guard<std::mutex> guard(lock);
+			released = true;
+		}
+		cv.notify_one();
+		acceptor.join();
+		return success && received == CONNECTION_COUNT;
+	}
+
+	// the ring watches the cancellation token next to the accept, no timeout slices are needed
+	bool TestCancelAccept()
+	{
+		auto server = CreateListener();
+		(void)server->setIoEngine(sdk::network::IoEngine::ioUring);
+		// the poll fallback can only watch the token of a non-blocking listener
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ *server };
+		serverOpt.setBlockingMode(sdk::network::SocketOpt::ON);
+		auto cancelToken = std::make_shared<sdk::network::CancellationToken>();
+		server->setCancellationToken(cancelToken);
+
+		std::thread canceller{ [&cancelToken]() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			cancelToken->cancel();
+		} };
+
+		bool cancelled = false;
+		const auto start = std::chrono::steady_clock::now();
+		try {
+			(void)server->accept();
+		}
+		catch (const sdk::general::SocketException& err) {
+			cancelled = err.getErrorMsg() == sdk::network::CANCEL_MSG;
+		}
+		canceller.join();
+		return cancelled && std::chrono::steady_clock::now() - start < std::chrono::seconds(1);
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		success = TestEngine() && TestCancelAccept();
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,218 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <network/Socket.h>
+#include <network/SocketOption.h>
+#include <network/SocketException.h>
+#include <network/Reactor.h>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <signal.h>
+#endif
+
+namespace {
+	const auto DEFAULT_LISTEN_PORT = 8081;
+	const auto DEFAULT_CLIENT = 10;
+
+	bool TestStopFromAnotherThread()
+	{
+		sdk::network::Reactor reactor;
+		std::thread stopper{ [&reactor]() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			reactor.stop();
+		} };
+
+		reactor.run(); // must return when stop is called
+		stopper.join();
+		return true;
+	}
+
+	bool TestEchoServer()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		serverOpt.setBlockingMode(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		sdk::network::Reactor reactor;
+		std::shared_ptr<sdk::network::SocketDescriptor> serverDescriptor;
+
+		reactor.add(server.getSocketId(), sdk::network::EVENT_READ, [&](SOCKET socketId, std::uint32_t events) {
+			(void)socketId;
+			(void)events;
+			serverDescriptor = server.createSocketDescriptor(server.accept());
+			reactor.add(serverDescriptor->getSocketId(), sdk::network::EVENT_READ, [&](SOCKET clientId, std::uint32_t clientEvents) {
+				(void)clientEvents;
+				std::string message;
+				if (serverDescriptor->read(message) > 0) {
+					std::cout << "Message from client: " << message << "\r\n";
+					(void)serverDescriptor->write("OK");
+				}
+				reactor.remove(clientId);
+				reactor.stop();
+			});
+		});
+
+		std::string response;
+		std::thread client{ [&response]() {
+			try {
+				sdk::network::Socket clientSocket{ DEFAULT_LISTEN_PORT };
+				clientSocket.setIpAddress("127.0.0.1");
+				clientSocket.connect();
+				auto socketDesc = clientSocket.createSocketDescriptor(clientSocket.getSocketId());
+				if (socketDesc->write("Hello from client!") > 0) {
+					(void)socketDesc->read(response);
+				}
+			}
+			catch (const sdk::general::SocketException& err) {
+				std::cout << err.getErrorMsg() << "\r\n";
+			}
+		} };
+
+		reactor.run();
+		client.join();
+
+		std::cout << "Response from server: " << response << "\r\n";
+		return response == "OK" && reactor.size() == 1;
+	}
+
+	bool TestCancelAccept()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setBlockingMode(sdk::network::SocketOpt::ON); // non-blocking mode
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		auto cancelToken = std::make_shared<sdk::network::CancellationToken>();
+		server.setCancellationToken(cancelToken);
+		std::thread canceller{ [&cancelToken]() {
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+			cancelToken->cancel();
+		} };
+
+		// accept waits without a timeout, only the cancellation can end it
+		bool cancelled = false;
+		try {
+			(void)server.accept();
+		}
+		catch (const sdk::general::SocketException& err) {
+			cancelled = err.getErrorMsg() == sdk::network::CANCEL_MSG;
+		}
+		canceller.join();
+
+		// a reset token lets the socket wait again
+		cancelToken->reset();
+		return cancelled && !cancelToken->isCancelled() &&
+			sdk::network::Reactor::waitFor(server.getSocketId(), sdk::network::EVENT_READ, 10, cancelToken.get()) == sdk::network::EVENT_NONE;
+	}
+
+	// signals that interrupt a wait must not extend its timeout
+	bool TestSignalsDuringWait()
+	{
+#ifdef _WIN32
+		return true;
+#else
+		struct sigaction action{};
+		action.sa_handler = [](int) {};
+		sigemptyset(&action.sa_mask);
+		struct sigaction oldAction{};
+		if (sigaction(SIGUSR1, &action, &oldAction) != 0) {
+			return false;
+		}
+
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		// the signals stop after a while, so a wait that restarts the timeout still ends
+		std::atomic<bool> done{};
+		const auto waiter = pthread_self();
+		std::thread signaller{ [&done, waiter]() {
+			for (int i = 0; i < 100 && !done; ++i) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+				(void)pthread_kill(waiter, SIGUSR1);
+			}
+		} };
+
+		const auto start = std::chrono::steady_clock::now();
+		const auto events = sdk::network::Reactor::waitFor(server.getSocketId(), sdk::network::EVENT_READ, 200);
+		const auto elapsed = std::chrono::steady_clock::now() - start;
+		done = true;
+		signaller.join();
+		(void)sigaction(SIGUSR1, &oldAction, nullptr);
+
+		return events == sdk::network::EVENT_NONE && elapsed >= std::chrono::milliseconds(200) &&
+			elapsed < std::chrono::milliseconds(1000);
+#endif
+	}
+
+	// a cancel() racing with reset() must leave the flag and the handle in step
+	bool TestCancelResetRace()
+	{
+		sdk::network::CancellationToken cancelToken;
+		for (int i = 0; i < 200; ++i) {
+			cancelToken.cancel();
+			std::thread canceller{ [&cancelToken]() { cancelToken.cancel(); } };
+			cancelToken.reset();
+			canceller.join();
+
+			const bool signalled = sdk::network::Reactor::waitFor(cancelToken.getWaitHandle(), sdk::network::EVENT_READ, 0) != sdk::network::EVENT_NONE;
+			if (signalled != cancelToken.isCancelled()) {
+				return false;
+			}
+			cancelToken.reset();
+		}
+		return true;
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		success = TestStopFromAnotherThread() && TestEchoServer() && TestCancelAccept() && TestCancelResetRace() &&
+			TestSignalsDuringWait();
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
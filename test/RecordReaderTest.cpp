@@ -0,0 +1,130 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+#include <network/Socket.h>
+#include <network/SocketOption.h>
+#include <network/SocketException.h>
+#include <network/RecordReader.h>
+
+namespace {
+	const auto DEFAULT_LISTEN_PORT = 8084;
+	const auto DEFAULT_CLIENT = 10;
+
+	bool TestFindByte()
+	{
+		using sdk::network::RecordReader;
+
+		// every length and position around the vector widths, from aligned and unaligned starts
+		std::string data(200, 'a');
+		for (std::size_t offset = 0; offset < 3; ++offset) {
+			for (std::size_t size = 0; size + offset <= 100; ++size) {
+				const char* begin = data.data() + offset;
+				if (RecordReader::findByte(begin, begin + size, '\n') != begin + size) {
+					return false;
+				}
+
+				for (std::size_t position = 0; position < size; ++position) {
+					data[offset + position] = '\n';
+					const char* found = RecordReader::findByte(begin, begin + size, '\n');
+					data[offset + position] = 'a';
+					if (found != begin + position) {
+						return false;
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	bool TestRecordsOverSocket()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		const std::string longLine(5000, 'y');
+		std::thread client{ [&longLine]() {
+			try {
+				sdk::network::Socket clientSocket{ DEFAULT_LISTEN_PORT };
+				clientSocket.setIpAddress("127.0.0.1");
+				clientSocket.connect();
+				auto socketDesc = clientSocket.createSocketDescriptor(clientSocket.getSocketId());
+
+				// two records in a single segment
+				(void)socketDesc->write("first\r\n\r\n");
+
+				// a record whose delimiter is split across segments
+				(void)socketDesc->write("split\r");
+				std::this_thread::sleep_for(std::chrono::milliseconds(50));
+				(void)socketDesc->write("\n" + longLine + "\r\nbare\nlast\r\nleft");
+			}
+			catch (const sdk::general::SocketException& err) {
+				std::cout << err.getErrorMsg() << "\r\n";
+			}
+		} };
+
+		auto serverDescriptor = server.createSocketDescriptor(server.accept());
+		sdk::network::RecordReader reader{ *serverDescriptor, "\r\n" };
+
+		std::string first;
+		std::string empty{ "not empty" };
+		std::string split;
+		std::string line;
+		std::string bare;
+		std::string left;
+		bool success = reader.readRecord(first) && reader.readRecord(empty) && reader.readRecord(split) &&
+			reader.readRecord(line) && reader.readRecord(bare);
+		client.join();
+
+		// the leftover bytes have no delimiter, they stay buffered
+		success = success && !reader.readRecord(left);
+
+		std::cout << "Records: " << first << ", " << empty.size() << ", " << split << ", " << line.size() << "\r\n";
+		return success && first == "first" && empty.empty() && split == "split" && line == longLine &&
+			bare == "bare\nlast" && reader.getBufferedSize() == 4;
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		success = TestFindByte() && TestRecordsOverSocket();
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
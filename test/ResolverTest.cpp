@@ -0,0 +1,100 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <string>
+#include <network/Socket.h>
+#include <network/SocketException.h>
+#include <network/Resolver.h>
+
+namespace {
+	const auto DEFAULT_PORT = 8087;
+
+	bool TestNumericAddress()
+	{
+		sdk::network::Resolver resolver;
+		const auto addresses = resolver.resolve("127.0.0.1", DEFAULT_PORT);
+
+		// numeric addresses are converted without a lookup
+		return addresses.size() == 1 && addresses.front().getPort() == DEFAULT_PORT && resolver.getCacheSize() == 0;
+	}
+
+	bool TestCachedLookup()
+	{
+		sdk::network::Resolver resolver;
+
+		// identical lookups share a single entry
+		auto first = resolver.resolveAsync("localhost", DEFAULT_PORT);
+		auto second = resolver.resolveAsync("localhost", DEFAULT_PORT);
+		const auto addresses = first.get();
+		if (addresses.empty() || second.get().size() != addresses.size() || resolver.getCacheSize() != 1) {
+			return false;
+		}
+
+		// udp sockets get datagram addresses
+		const auto datagramAddresses = resolver.resolve("localhost", DEFAULT_PORT, sdk::network::ProtocolType::udp);
+		if (datagramAddresses.empty() || resolver.getCacheSize() != 2) {
+			return false;
+		}
+
+		std::cout << "localhost: " << addresses.front().getIpAddress() << ":" << addresses.front().getPort() << "\r\n";
+		resolver.clear();
+		return resolver.getCacheSize() == 0;
+	}
+
+	bool TestNegativeLookup()
+	{
+		sdk::network::Resolver resolver;
+
+		int failCount = 0;
+		for (int attempt = 0; attempt < 2; ++attempt) {
+			try {
+				(void)resolver.resolve("nonexistent.invalid", DEFAULT_PORT);
+			}
+			catch (const sdk::general::SocketException&) {
+				++failCount;
+			}
+		}
+
+		// the failure is cached as well
+		return failCount == 2 && resolver.getCacheSize() == 1;
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		success = TestNumericAddress() && TestCachedLookup() && TestNegativeLookup();
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,126 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <string>
+#include <thread>
+#include <network/Socket.h>
+#include <network/SocketOption.h>
+#include <network/SocketException.h>
+#include <network/RingBuffer.h>
+
+namespace {
+	const auto DEFAULT_LISTEN_PORT = 8085;
+	const auto DEFAULT_CLIENT = 10;
+
+	bool TestWrappedView()
+	{
+		sdk::network::RingBuffer ring{ 1 };
+		const auto capacity = ring.capacity();
+		if (capacity == 0 || ring.writableSize() != capacity) {
+			return false;
+		}
+
+		// move the readable bytes close to the end, then write past it
+		ring.commit(capacity - 3);
+		ring.consume(capacity - 3);
+
+		const std::string message{ "wrapped message" };
+		std::memcpy(ring.writeData(), message.data(), message.size());
+		ring.commit(message.size());
+
+		std::cout << "Ring buffer: " << capacity << " bytes, mirrored: " << ring.isMirrored() << "\r\n";
+		return ring.size() == message.size() && std::string(ring.data(), ring.size()) == message;
+	}
+
+	// a capacity that cannot be rounded up must fail instead of looping forever
+	bool TestHugeCapacity()
+	{
+		try {
+			sdk::network::RingBuffer ring{ (std::numeric_limits<std::size_t>::max)() };
+			return false;
+		}
+		catch (const std::bad_alloc&) {
+			return true;
+		}
+	}
+
+	bool TestReadIntoRing()
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		const std::string payload(10000, 'r');
+		std::thread client{ [&payload]() {
+			try {
+				sdk::network::Socket clientSocket{ DEFAULT_LISTEN_PORT };
+				clientSocket.setIpAddress("127.0.0.1");
+				clientSocket.connect();
+				auto socketDesc = clientSocket.createSocketDescriptor(clientSocket.getSocketId());
+				(void)socketDesc->write(payload);
+			}
+			catch (const sdk::general::SocketException& err) {
+				std::cout << err.getErrorMsg() << "\r\n";
+			}
+		} };
+
+		auto serverDescriptor = server.createSocketDescriptor(server.accept());
+		sdk::network::RingBuffer ring{ 4096 };
+
+		// consume in small steps so the free space keeps wrapping around
+		std::string received;
+		while (serverDescriptor->read(ring) > 0 || !ring.empty()) {
+			const auto chunk = (std::min)(ring.size(), static_cast<std::size_t>(1000));
+			received.append(ring.data(), chunk);
+			ring.consume(chunk);
+		}
+		client.join();
+
+		return received == payload;
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		success = TestWrappedView() && TestHugeCapacity() && TestReadIntoRing();
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
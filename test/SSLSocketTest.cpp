@@ -0,0 +1,215 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <network/SSLSocket.h>
+#include <network/SSLSocketDescriptor.h>
+#include <network/SocketOption.h>
+#include <network/SocketException.h>
+
+#if OPENSSL_SUPPORTED
+#include <openssl/evp.h>
+#include <openssl/x509.h>
+#endif // OPENSSL_SUPPORTED
+
+namespace {
+#if OPENSSL_SUPPORTED
+	const auto DEFAULT_LISTEN_PORT = 8095;
+	const auto DEFAULT_CLIENT = 10;
+
+	using Clock = std::chrono::steady_clock;
+	using EVP_PKEY_unique_ptr = std::unique_ptr<EVP_PKEY, decltype(&EVP_PKEY_free)>;
+	using X509_unique_ptr = std::unique_ptr<X509, decltype(&X509_free)>;
+
+	// a self signed certificate, so the test does not depend on files
+	struct Identity {
+		EVP_PKEY_unique_ptr key{ nullptr, EVP_PKEY_free };
+		X509_unique_ptr cert{ nullptr, X509_free };
+	};
+
+	Identity CreateIdentity()
+	{
+		Identity identity;
+		std::unique_ptr<EVP_PKEY_CTX, decltype(&EVP_PKEY_CTX_free)> keyCtx{ EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr), EVP_PKEY_CTX_free };
+		EVP_PKEY* key = nullptr;
+		if (!keyCtx || EVP_PKEY_keygen_init(keyCtx.get()) <= 0 ||
+			EVP_PKEY_CTX_set_ec_paramgen_curve_nid(keyCtx.get(), NID_X9_62_prime256v1) <= 0 ||
+			EVP_PKEY_keygen(keyCtx.get(), &key) <= 0) {
+			throw sdk::general::SSLSocketException("key generation failed");
+		}
+		identity.key.reset(key);
+
+		identity.cert.reset(X509_new());
+		auto* cert = identity.cert.get();
+		auto* name = X509_get_subject_name(cert);
+		if (ASN1_INTEGER_set(X509_get_serialNumber(cert), 1) != 1 ||
+			X509_gmtime_adj(X509_getm_notBefore(cert), 0) == nullptr ||
+			X509_gmtime_adj(X509_getm_notAfter(cert), 3600) == nullptr ||
+			X509_set_pubkey(cert, key) != 1 ||
+			X509_NAME_add_entry_by_txt(name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("localhost"), -1, -1, 0) != 1 ||
+			X509_set_issuer_name(cert, name) != 1 ||
+			X509_sign(cert, key, EVP_sha256()) <= 0) {
+			throw sdk::general::SSLSocketException("certificate generation failed");
+		}
+		return identity;
+	}
+
+	// the server verifies the client, both use the same trusted certificate
+	void UseIdentity(const sdk::network::SSLSocket& sslSocket, const Identity& identity)
+	{
+		auto* ctx = sslSocket.getSSLCtx();
+		if (SSL_CTX_use_certificate(ctx, identity.cert.get()) != 1 ||
+			SSL_CTX_use_PrivateKey(ctx, identity.key.get()) != 1 ||
+			X509_STORE_add_cert(SSL_CTX_get_cert_store(ctx), identity.cert.get()) != 1) {
+			throw sdk::general::SSLSocketException("certificate could not be used");
+		}
+	}
+
+	struct Connection {
+		std::shared_ptr<sdk::network::SSLSocketDescriptor> server;
+		std::shared_ptr<sdk::network::SSLSocketDescriptor> client;
+	};
+
+	// completes the handshake of a client with the listening server
+	Connection Connect(sdk::network::SSLSocket& server, sdk::network::SSLSocket& client)
+	{
+		Connection connection;
+		std::thread acceptor([&server, &connection] {
+			try {
+				auto socketDesc = server.createSocketDescriptor(server.accept());
+				socketDesc->accept();
+				connection.server = socketDesc;
+			}
+			catch (const sdk::general::SocketException& err) {
+				std::cout << err.getErrorMsg() << "\r\n";
+			}
+		});
+
+		try {
+			client.setIpAddress("127.0.0.1");
+			client.connect();
+			connection.client = client.createSocketDescriptor(client.getSocketId());
+			connection.client->connect();
+		}
+		catch (...) {
+			acceptor.join();
+			throw;
+		}
+		acceptor.join();
+		return connection;
+	}
+
+	// a peer that does not read fills the send buffer, the timeout must end SSL_write on a blocking socket
+	bool TestWriteTimeout(sdk::network::SSLSocket& server, const Identity& identity)
+	{
+		sdk::network::SSLSocket client{ DEFAULT_LISTEN_PORT, sdk::network::ConnMethod::client };
+		UseIdentity(client, identity);
+		const auto connection = Connect(server, client);
+		if (!connection.server) {
+			return false;
+		}
+
+		const std::string message(64 * 1024 * 1024, 'x');
+		const auto start = Clock::now();
+		const auto sendBytes = connection.client->writeAll(message.data(), message.size(), std::chrono::milliseconds(200));
+		const auto elapsed = Clock::now() - start;
+		return sendBytes > 0 && sendBytes < message.size() &&
+			elapsed >= std::chrono::milliseconds(200) && elapsed < std::chrono::seconds(2);
+	}
+
+	// an idle read on a non-blocking socket must wait for readiness, not retry SSL_read in a loop
+	bool TestIdleRead(sdk::network::SSLSocket& server, const Identity& identity)
+	{
+		sdk::network::SSLSocket client{ DEFAULT_LISTEN_PORT, sdk::network::ConnMethod::client };
+		UseIdentity(client, identity);
+		auto connection = Connect(server, client);
+		if (!connection.server) {
+			return false;
+		}
+
+		sdk::network::SocketOption<sdk::network::SocketDescriptor> descOpt{ *connection.client };
+		descOpt.setBlockingMode(sdk::network::SocketOpt::ON);
+		descOpt.setRecvTimeout(0, 300000);
+
+		char buffer[64];
+		const auto start = Clock::now();
+		const auto cpuStart = std::clock();
+		if (connection.client->read(buffer, sizeof(buffer)) != 0) {
+			return false;
+		}
+		const auto cpuTime = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+		const auto elapsed = Clock::now() - start;
+		if (elapsed < std::chrono::milliseconds(300) || cpuTime > 0.1) {
+			return false;
+		}
+
+		// the data of the peer still arrives after the idle wait
+		const std::string message{ "idle" };
+		if (connection.server->write(message) != static_cast<int>(message.size()) ||
+			connection.client->read(buffer, sizeof(buffer)) != message.size()) {
+			return false;
+		}
+
+		// the close_notify of a peer that is gone cannot keep the shutdown loop busy
+		connection.server.reset();
+		const auto closeStart = Clock::now();
+		connection.client.reset();
+		return Clock::now() - closeStart < std::chrono::seconds(2);
+	}
+#endif // OPENSSL_SUPPORTED
+}
+
+int main()
+{
+#if OPENSSL_SUPPORTED
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		const auto identity = CreateIdentity();
+		sdk::network::SSLSocket server{ DEFAULT_LISTEN_PORT, sdk::network::ConnMethod::server };
+		UseIdentity(server, identity);
+		sdk::network::SocketOption<sdk::network::SSLSocket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		success = TestWriteTimeout(server, identity) && TestIdleRead(server, identity);
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+#else
+	return EXIT_SUCCESS;
+#endif // OPENSSL_SUPPORTED
+}
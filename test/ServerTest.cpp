@@ -0,0 +1,366 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <ctime>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <application/server/Server.h>
+#include <network/Socket.h>
+#include <network/SocketOption.h>
+#include <network/SocketException.h>
+
+#ifdef __linux__
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace {
+	const auto DEFAULT_LISTEN_PORT = 8093;
+	const auto SHARD_COUNT = 3;
+	const auto BACKLOG = 8;
+	const auto CONNECTION_COUNT = 12;
+	const auto FAST_OPEN_QUEUE_LENGTH = 16;
+	const auto QUEUED_CONNECTIONS = 2;
+
+	// the listeners are reported by getStats() once they are listening, the statistics are only collected on Linux
+	bool WaitForListeners(const sdk::application::Server& server, std::uint32_t acceptQueueLimit)
+	{
+#ifndef __linux__
+		(void)server;
+		(void)acceptQueueLimit;
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		return true;
+#endif
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+		while (server.getStats().acceptQueueLimit != acceptQueueLimit) {
+			if (std::chrono::steady_clock::now() >= deadline) {
+				return false;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		return true;
+	}
+
+#ifdef __linux__
+	// the listening socket of the server on the port, -1 if there is none
+	int FindListener(int port)
+	{
+		for (int fd = 3; fd < 1024; ++fd) {
+			int accepting = 0;
+			socklen_t optionSize = sizeof(accepting);
+			struct sockaddr_in address{};
+			socklen_t addressSize = sizeof(address);
+			if (getsockopt(fd, SOL_SOCKET, SO_ACCEPTCONN, &accepting, &optionSize) == 0 && accepting != 0 &&
+				getsockname(fd, reinterpret_cast<struct sockaddr*>(&address), &addressSize) == 0 &&
+				ntohs(address.sin_port) == port) {
+				return fd;
+			}
+		}
+		return -1;
+	}
+#endif
+
+	bool TestShards()
+	{
+		bool success = true;
+		{
+			sdk::application::Server server{ DEFAULT_LISTEN_PORT };
+			server.setShardCount(SHARD_COUNT);
+			server.setBacklog(BACKLOG);
+
+			std::thread listener{ [&server]() {
+				try {
+					server.startListening();
+				}
+				catch (const sdk::general::SocketException& err) {
+					std::cout << err.getErrorMsg() << "\r\n";
+				}
+			} };
+
+			// every shard is a listener of its own with the same backlog
+			success = WaitForListeners(server, SHARD_COUNT * BACKLOG);
+
+			try {
+				for (int i = 0; success && i < CONNECTION_COUNT; ++i) {
+					sdk::network::Socket client{ DEFAULT_LISTEN_PORT };
+					client.setIpAddress("127.0.0.1");
+					client.connect();
+					auto clientDesc = client.createSocketDescriptor(client.getSocketId());
+					std::string response;
+					success = clientDesc->write("Hello from client!") > 0 && clientDesc->read(response) > 0 &&
+						response == "Hello from Server!\n";
+				}
+			}
+			catch (const sdk::general::SocketException& err) {
+				std::cout << err.getErrorMsg() << "\r\n";
+				success = false;
+			}
+
+			// the abort wakes up the idle accept loops of all shards
+			const auto start = std::chrono::steady_clock::now();
+			server.abortListening();
+			listener.join();
+			success = success && std::chrono::steady_clock::now() - start < std::chrono::seconds(1);
+
+			// the shards are closed once startListening() returns
+			success = success && server.getStats().acceptQueueLimit == 0;
+		}
+
+		// no shard is left bound to the port
+		sdk::network::Socket newServer{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ newServer };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		newServer.bind();
+		newServer.listen(BACKLOG);
+		return success;
+	}
+
+	// a connection that stays silent is shut down by the timer wheel of the accept loop
+	bool TestConnectionTimeout()
+	{
+		sdk::application::Server server{ DEFAULT_LISTEN_PORT };
+		server.setBacklog(BACKLOG);
+		server.setWorkerCount(2);
+		server.setConnectionTimeout(std::chrono::milliseconds(200));
+
+		std::thread listener{ [&server]() {
+			try {
+				server.startListening();
+			}
+			catch (const sdk::general::SocketException& err) {
+				std::cout << err.getErrorMsg() << "\r\n";
+			}
+		} };
+
+		bool success = WaitForListeners(server, BACKLOG);
+		try {
+			sdk::network::Socket client{ DEFAULT_LISTEN_PORT };
+			client.setIpAddress("127.0.0.1");
+			client.connect();
+			auto clientDesc = client.createSocketDescriptor(client.getSocketId());
+
+			// the handler waits for a request that never comes, the timeout closes the connection
+			std::string response;
+			const auto start = std::chrono::steady_clock::now();
+			const auto readBytes = clientDesc->read(response, start + std::chrono::seconds(2));
+			const auto elapsed = std::chrono::steady_clock::now() - start;
+			success = success && readBytes == 0 && elapsed >= std::chrono::milliseconds(150) &&
+				elapsed < std::chrono::seconds(1);
+		}
+		catch (const sdk::general::SocketException& err) {
+			std::cout << err.getErrorMsg() << "\r\n";
+			success = false;
+		}
+
+		server.abortListening();
+		listener.join();
+		return success;
+	}
+
+	// the listener options are applied to the listening socket before the server accepts
+	bool TestListenerOptions()
+	{
+#ifndef __linux__
+		return true;
+#else
+		sdk::application::Server server{ DEFAULT_LISTEN_PORT };
+		server.setBacklog(BACKLOG);
+		server.setDeferAccept(std::chrono::seconds(1));
+		server.setFastOpenQueueLength(FAST_OPEN_QUEUE_LENGTH);
+
+		std::thread listener{ [&server]() {
+			try {
+				server.startListening();
+			}
+			catch (const sdk::general::SocketException& err) {
+				std::cout << err.getErrorMsg() << "\r\n";
+			}
+		} };
+
+		bool success = WaitForListeners(server, BACKLOG);
+		const int listenerId = FindListener(DEFAULT_LISTEN_PORT);
+		int deferAccept = 0;
+		int fastOpen = 0;
+		socklen_t optionSize = sizeof(int);
+		success = success && listenerId >= 0 &&
+			getsockopt(listenerId, IPPROTO_TCP, TCP_DEFER_ACCEPT, &deferAccept, &optionSize) == 0 && deferAccept > 0 &&
+			getsockopt(listenerId, IPPROTO_TCP, TCP_FASTOPEN, &fastOpen, &optionSize) == 0 &&
+			fastOpen == FAST_OPEN_QUEUE_LENGTH;
+
+		server.abortListening();
+		listener.join();
+		return success;
+#endif
+	}
+
+	// connections wait in the accept queue while the single accept loop is busy with a handler
+	bool TestStats()
+	{
+#ifndef __linux__
+		return true;
+#else
+		sdk::application::Server server{ DEFAULT_LISTEN_PORT };
+		server.setBacklog(BACKLOG);
+
+		std::thread listener{ [&server]() {
+			try {
+				server.startListening();
+			}
+			catch (const sdk::general::SocketException& err) {
+				std::cout << err.getErrorMsg() << "\r\n";
+			}
+		} };
+
+		bool success = WaitForListeners(server, BACKLOG) && server.getStats().acceptQueueLength == 0;
+		try {
+			// the handler runs on the accept loop and waits for the request of the first client
+			sdk::network::Socket busyClient{ DEFAULT_LISTEN_PORT };
+			busyClient.setIpAddress("127.0.0.1");
+			busyClient.connect();
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+			std::vector<std::unique_ptr<sdk::network::Socket>> clients;
+			for (int i = 0; i < QUEUED_CONNECTIONS; ++i) {
+				clients.emplace_back(new sdk::network::Socket{ DEFAULT_LISTEN_PORT });
+				clients.back()->setIpAddress("127.0.0.1");
+				clients.back()->connect();
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+			success = success && server.getStats().acceptQueueLength == QUEUED_CONNECTIONS;
+
+			// the request frees the accept loop, it drains the queue
+			auto busyDesc = busyClient.createSocketDescriptor(busyClient.getSocketId());
+			std::string response;
+			success = success && busyDesc->write("Hello from client!") > 0 &&
+				busyDesc->read(response, std::chrono::steady_clock::now() + std::chrono::seconds(2)) > 0;
+			for (auto& client : clients) {
+				auto clientDesc = client->createSocketDescriptor(client->getSocketId());
+				success = success && clientDesc->write("Hello from client!") > 0 &&
+					clientDesc->read(response, std::chrono::steady_clock::now() + std::chrono::seconds(2)) > 0;
+			}
+			success = success && server.getStats().acceptQueueLength == 0;
+		}
+		catch (const sdk::general::SocketException& err) {
+			std::cout << err.getErrorMsg() << "\r\n";
+			success = false;
+		}
+
+		server.abortListening();
+		listener.join();
+
+		// the listeners are not reported once the server stops
+		return success && server.getStats().acceptQueueLimit == 0;
+#endif
+	}
+
+	// a process out of descriptors must not spin on the listener, the connection is accepted once they are back
+	bool TestAcceptBackoff()
+	{
+#ifndef __linux__
+		return true;
+#else
+		sdk::application::Server server{ DEFAULT_LISTEN_PORT };
+		server.setBacklog(BACKLOG);
+
+		std::thread listener{ [&server]() {
+			try {
+				server.startListening();
+			}
+			catch (const sdk::general::SocketException& err) {
+				std::cout << err.getErrorMsg() << "\r\n";
+			}
+		} };
+
+		bool success = WaitForListeners(server, BACKLOG);
+		struct rlimit oldLimit{};
+		success = success && getrlimit(RLIMIT_NOFILE, &oldLimit) == 0;
+		try {
+			sdk::network::Socket client{ DEFAULT_LISTEN_PORT };
+			client.setIpAddress("127.0.0.1");
+
+			// the descriptor table is filled after the client socket is created
+			struct rlimit newLimit = oldLimit;
+			newLimit.rlim_cur = 256;
+			std::vector<int> fillers;
+			if (success && setrlimit(RLIMIT_NOFILE, &newLimit) == 0) {
+				for (int fd = dup(0); fd >= 0; fd = dup(0)) {
+					fillers.push_back(fd);
+				}
+
+				client.connect();
+				const auto cpuStart = std::clock();
+				std::this_thread::sleep_for(std::chrono::milliseconds(500));
+				success = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC < 0.2;
+			}
+			else {
+				success = false;
+			}
+
+			for (const auto fd : fillers) {
+				close(fd);
+			}
+			(void)setrlimit(RLIMIT_NOFILE, &oldLimit);
+
+			auto clientDesc = client.createSocketDescriptor(client.getSocketId());
+			std::string response;
+			success = success && clientDesc->write("Hello from client!") > 0 &&
+				clientDesc->read(response, std::chrono::steady_clock::now() + std::chrono::seconds(2)) > 0 &&
+				response == "Hello from Server!\n";
+		}
+		catch (const sdk::general::SocketException& err) {
+			std::cout << err.getErrorMsg() << "\r\n";
+			success = false;
+		}
+
+		server.abortListening();
+		listener.join();
+		return success;
+#endif
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		success = TestShards() && TestConnectionTimeout() && TestListenerOptions() && TestStats() &&
+			TestAcceptBackoff();
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,128 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <vector>
+#include <application/server/ThreadPool.h>
+
+namespace {
+	const auto TASK_COUNT = 1000;
+
+	class OrderLog {
+	public:
+		void add(int value)
+		{
+			{
+				std::lock_guard<std::mutex> lock{ m_lock };
+				m_values.push_back(value);
+			}
+			m_cond.notify_all();
+		}
+
+		bool waitFor(std::size_t count)
+		{
+			std::unique_lock<std::mutex> lock{ m_lock };
+			return m_cond.wait_for(lock, std::chrono::seconds(2), [this, count]() {
+				return m_values.size() >= count;
+			});
+		}
+
+		std::vector<int> values()
+		{
+			std::lock_guard<std::mutex> lock{ m_lock };
+			return m_values;
+		}
+
+	private:
+		std::mutex m_lock;
+		std::condition_variable m_cond;
+		std::vector<int> m_values;
+	};
+
+	// the tasks submitted from outside and from the workers all run before the pool is destroyed
+	bool TestRunsAllTasks()
+	{
+		std::atomic<int> count{};
+		{
+			sdk::application::ThreadPool pool{ 4 };
+			for (int i = 0; i < TASK_COUNT; ++i) {
+				pool.submit([&pool, &count]() {
+					++count;
+					pool.submit([&count]() {
+						++count;
+					});
+				});
+			}
+		}
+		return count == 2 * TASK_COUNT;
+	}
+
+	// a worker runs the newest task of its own queue first
+	bool TestOwnerRunsNewestFirst()
+	{
+		OrderLog log;
+		{
+			sdk::application::ThreadPool pool{ 1 };
+			pool.submit([&pool, &log]() {
+				for (int i = 0; i < 3; ++i) {
+					pool.submit([&log, i]() {
+						log.add(i);
+					});
+				}
+			});
+		}
+		return log.values() == std::vector<int>{ 2, 1, 0 };
+	}
+
+	// an idle worker steals the oldest task of a busy worker
+	bool TestThiefRunsOldestFirst()
+	{
+		OrderLog log;
+		bool stolen = false;
+		{
+			sdk::application::ThreadPool pool{ 2 };
+			pool.submit([&pool, &log, &stolen]() {
+				for (int i = 0; i < 3; ++i) {
+					pool.submit([&log, i]() {
+						log.add(i);
+					});
+				}
+				// keep this worker busy, so the other one runs the tasks
+				stolen = log.waitFor(3);
+			});
+
+			// workers leave once the pool is stopping and no task is queued, so do not stop it early
+			(void)log.waitFor(3);
+		}
+		return stolen && log.values() == std::vector<int>{ 0, 1, 2 };
+	}
+}
+
+int main()
+{
+	const bool success = TestRunsAllTasks() && TestOwnerRunsNewestFirst() && TestThiefRunsOldestFirst();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,150 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <network/Socket.h>
+#include <network/SocketException.h>
+#include <network/Reactor.h>
+#include <network/TimerWheel.h>
+
+namespace {
+	using Clock = sdk::network::TimerWheel::Clock;
+
+	bool TestExpirationOrder()
+	{
+		sdk::network::TimerWheel timers;
+		std::vector<int> order;
+		(void)timers.schedule(std::chrono::milliseconds(300), [&order]() { order.push_back(3); });
+		(void)timers.schedule(std::chrono::milliseconds(100), [&order]() { order.push_back(1); });
+		(void)timers.schedule(std::chrono::milliseconds(200), [&order]() { order.push_back(2); });
+
+		// a timer never expires before its delay
+		const auto now = Clock::now();
+		if (timers.advance(now) != 0) {
+			return false;
+		}
+
+		return timers.advance(now + std::chrono::seconds(1)) == 3 &&
+			order == std::vector<int>{ 1, 2, 3 } && timers.empty();
+	}
+
+	bool TestCancelAndReschedule()
+	{
+		sdk::network::TimerWheel timers;
+		int fired = 0;
+		const auto cancelled = timers.schedule(std::chrono::milliseconds(50), [&fired]() { fired += 100; });
+		const auto moved = timers.schedule(std::chrono::milliseconds(50), [&fired]() { ++fired; });
+
+		const auto now = Clock::now();
+		if (!timers.cancel(cancelled) || timers.cancel(cancelled) ||
+			!timers.reschedule(moved, std::chrono::seconds(5))) {
+			return false;
+		}
+
+		if (timers.advance(now + std::chrono::seconds(1)) != 0 || timers.size() != 1) {
+			return false;
+		}
+
+		// an expired timer can not be cancelled, its id is not reused
+		return timers.advance(now + std::chrono::seconds(6)) == 1 && fired == 1 && !timers.cancel(moved);
+	}
+
+	bool TestLongDelays()
+	{
+		// beyond the range of the wheel, the timer is cascaded down several times
+		sdk::network::TimerWheel timers;
+		int fired = 0;
+		(void)timers.schedule(std::chrono::hours(50), [&fired]() { ++fired; });
+		(void)timers.schedule(std::chrono::minutes(10), [&fired]() { ++fired; });
+
+		const auto now = Clock::now();
+		if (timers.advance(now + std::chrono::minutes(9)) != 0 ||
+			timers.advance(now + std::chrono::minutes(11)) != 1 ||
+			timers.advance(now + std::chrono::hours(49)) != 0) {
+			return false;
+		}
+
+		return timers.advance(now + std::chrono::hours(51)) == 1 && fired == 2 && timers.empty();
+	}
+
+	bool TestManyTimers()
+	{
+		constexpr const auto TIMER_COUNT = 100000;
+
+		sdk::network::TimerWheel timers;
+		std::vector<sdk::network::TimerId> timerIds;
+		timerIds.reserve(TIMER_COUNT);
+		int fired = 0;
+		for (int i = 0; i < TIMER_COUNT; ++i) {
+			timerIds.push_back(timers.schedule(std::chrono::milliseconds(i * 7 % 60000), [&fired]() { ++fired; }));
+		}
+
+		for (int i = 0; i < TIMER_COUNT; i += 2) {
+			(void)timers.cancel(timerIds[i]);
+		}
+
+		return timers.advance(Clock::now() + std::chrono::minutes(2)) == TIMER_COUNT / 2 &&
+			fired == TIMER_COUNT / 2;
+	}
+
+	bool TestReactorTimers()
+	{
+		// the reactor wakes up for its timers, there is no socket to wait for
+		sdk::network::Reactor reactor;
+		int ticks = 0;
+		std::function<void()> onTick;
+		onTick = [&]() {
+			if (++ticks == 3) {
+				reactor.stop();
+				return;
+			}
+			(void)reactor.getTimers().schedule(std::chrono::milliseconds(20), onTick);
+		};
+		(void)reactor.getTimers().schedule(std::chrono::milliseconds(20), onTick);
+
+		const auto start = Clock::now();
+		reactor.run();
+		return ticks == 3 && Clock::now() - start >= std::chrono::milliseconds(60);
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		success = TestExpirationOrder() && TestCancelAndReschedule() && TestLongDelays() &&
+			TestManyTimers() && TestReactorTimers();
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,141 @@
+// MIT License
+
+// Copyright (c) 2021-2026 kadirlua
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <network/Socket.h>
+#include <network/SocketOption.h>
+#include <network/SocketException.h>
+
+namespace {
+	const auto DEFAULT_LISTEN_PORT = 8094;
+	const auto DEFAULT_CLIENT = 10;
+	const std::uint32_t COPIED_SEND_COUNT = 3;
+	const std::uint32_t ZERO_COPY_SEND_COUNT = 20000;
+
+	// marks the reported sequences, every send must be reported exactly once
+	bool WaitForCompletions(sdk::network::SocketDescriptor& socketDesc, std::uint32_t sendCount)
+	{
+		std::vector<bool> reported(sendCount);
+		std::uint32_t reportedCount = 0;
+		std::vector<sdk::network::ZeroCopyCompletion> completions;
+
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (reportedCount < sendCount && std::chrono::steady_clock::now() < deadline) {
+			completions.clear();
+			(void)socketDesc.pollZeroCopyCompletions(completions, 100);
+			for (const auto& completion : completions) {
+				for (auto sequence = completion.first; sequence != completion.last + 1; ++sequence) {
+					if (sequence >= sendCount || reported[sequence]) {
+						return false;
+					}
+					reported[sequence] = true;
+					++reportedCount;
+				}
+			}
+		}
+		return reportedCount == sendCount;
+	}
+
+	bool TestZeroCopy(bool enable, std::uint32_t sendCount)
+	{
+		sdk::network::Socket server{ DEFAULT_LISTEN_PORT };
+		sdk::network::SocketOption<sdk::network::Socket> serverOpt{ server };
+		serverOpt.setReuseAddr(sdk::network::SocketOpt::ON);
+		server.bind();
+		server.listen(DEFAULT_CLIENT);
+
+		sdk::network::Socket client{ DEFAULT_LISTEN_PORT };
+		client.setIpAddress("127.0.0.1");
+		client.connect();
+		auto clientDesc = client.createSocketDescriptor(client.getSocketId());
+		auto serverDesc = server.createSocketDescriptor(server.accept());
+
+		if (enable) {
+			sdk::network::SocketOption<sdk::network::SocketDescriptor> clientOpt{ *clientDesc };
+			clientOpt.setZeroCopy(sdk::network::SocketOpt::ON);
+		}
+
+		const std::string message(100, 'z');
+		const std::size_t totalSize = message.size() * sendCount;
+		std::size_t receivedSize = 0;
+		std::thread reader{ [&serverDesc, &receivedSize, totalSize]() {
+			try {
+				std::vector<char> buffer(65536);
+				std::size_t readBytes = 0;
+				while (receivedSize < totalSize && (readBytes = serverDesc->read(buffer.data(), buffer.size())) > 0) {
+					receivedSize += readBytes;
+				}
+			}
+			catch (const sdk::general::SocketException& err) {
+				std::cout << err.getErrorMsg() << "\r\n";
+			}
+		} };
+
+		bool success = true;
+		try {
+			// the buffer is not modified, so it may be sent again before the completion
+			for (std::uint32_t i = 0; success && i < sendCount; ++i) {
+				std::uint32_t sequence = 0;
+				success = clientDesc->writeZeroCopy(message.data(), message.size(), sequence) == message.size() &&
+					sequence == i;
+			}
+			success = success && WaitForCompletions(*clientDesc, sendCount);
+		}
+		catch (const sdk::general::SocketException& err) {
+			std::cout << err.getErrorMsg() << "\r\n";
+			success = false;
+		}
+
+		// the reader ends when the connection is closed
+		shutdown(client.getSocketId(), SD_BOTH);
+		reader.join();
+		return success && receivedSize == totalSize;
+	}
+}
+
+int main()
+{
+	if (!sdk::network::Socket::WSAInit(sdk::network::WSA_VER_2_2)) {
+		std::cout << "sdk::network::Socket::WSAInit failed\r\n";
+		return EXIT_FAILURE;
+	}
+
+	bool success = false;
+	try {
+		// without the option the data is copied and the sends are reported right away
+		success = TestZeroCopy(false, COPIED_SEND_COUNT);
+#if defined(__linux__) && defined(SO_ZEROCOPY)
+		success = success && TestZeroCopy(true, ZERO_COPY_SEND_COUNT);
+#endif
+	}
+	catch (const sdk::general::SocketException& err) {
+		std::cout << err.getErrorMsg() << "\r\n";
+	}
+
+	sdk::network::Socket::WSADeinit();
+	return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}